@@ -0,0 +1,240 @@
+#!/bin/bash
+# Benchmarks for the grades program
+# Usage: ./bench.sh [workspace|stream|pipeline|index|all]
+#
+# Each benchmark generates its data with gen_data.sh in a temporary
+# directory and prints one line per measurement. Sizes can be changed
+# through the environment variables named in each section.
+
+cd "$(dirname "$0")" || exit 1
+make -s || exit 1
+
+GRADES="$PWD/grades"
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+# Print the wall-clock seconds taken by a command
+# Usage: seconds INPUT OUTPUT COMMAND [ARGS...]
+seconds() {
+    local input=$1 output=$2 start end
+    shift 2
+    start=$(date +%s%N)
+    "$@" < "$input" > "$output"
+    end=$(date +%s%N)
+    awk -v ns=$((end - start)) 'BEGIN { printf "%.3f", ns / 1e9 }'
+}
+
+# Print the best of three runs of seconds, to keep noise out of short timings
+# Usage: best_seconds INPUT OUTPUT COMMAND [ARGS...]
+best_seconds() {
+    local run
+    for run in 1 2 3; do
+        seconds "$@"
+        echo
+    done | sort -n | head -n 1
+}
+
+# Generate a random command script for two courses named c1 and c2
+# Usage: gen_script COMMANDS STUDENTS ASSIGNMENTS
+gen_script() {
+    awk -v n="$1" -v students="$2" -v assignments="$3" '
+    BEGIN {
+        srand(7)
+        families = split("HW Lab Quiz Project Exam", family, " ")
+        for (i = 0; i < n; i++) {
+            a = int(rand() * assignments)
+            name = family[a % families + 1] " " (int(a / families) + 1)
+            id = 1000000000 + int(rand() * students)
+            r = rand()
+            if (r < 0.30)      print "add " id ":" name ":" int(rand() * 101)
+            else if (r < 0.55) print "remove " id ":" name
+            else if (r < 0.70) print "stats " name
+            else if (r < 0.75) print "stats " family[a % families + 1] "*"
+            else if (r < 0.80) print "student " id
+            else if (r < 0.83) print "print " name
+            else if (r < 0.88) print "use c" (int(rand() * 2) + 1)
+            else if (r < 0.90) print "courses"
+            else if (r < 0.94) print "stats " name " --all"
+            else if (r < 0.97) print "student " id " --all"
+            else               print "bogus"
+        }
+    }'
+}
+
+# Pipelined vs sequential execution of the same script
+# PIPELINE_COMMANDS sets the script length (default 10^6)
+bench_pipeline() {
+    local n=${PIPELINE_COMMANDS:-1000000}
+    gen_script "$n" 40 10 > "$work/script.txt"
+
+    local mode t
+    for mode in sequential pipeline; do
+        mkdir -p "$work/$mode"
+        ./gen_data.sh 200 10 40 1 > "$work/$mode/c1.txt"
+        ./gen_data.sh 200 10 40 2 > "$work/$mode/c2.txt"
+
+        local flag=""
+        [ "$mode" = pipeline ] && flag="--pipeline"
+        t=$(seconds "$work/script.txt" "$work/$mode.out" \
+                "$GRADES" $flag "$work/$mode/c1.txt" "$work/$mode/c2.txt")
+        echo "pipeline: $n commands, $mode mode: ${t}s"
+    done
+
+    # Output and saved databases must match byte for byte
+    if cmp -s "$work/sequential.out" "$work/pipeline.out" &&
+       cmp -s "$work/sequential/c1.txt" "$work/pipeline/c1.txt" &&
+       cmp -s "$work/sequential/c2.txt" "$work/pipeline/c2.txt"; then
+        echo "pipeline: output and databases identical ($(wc -c < "$work/sequential.out") bytes of output)"
+    else
+        echo "pipeline: OUTPUT DIFFERS"
+        return 1
+    fi
+}
+
+# Cross-course query latency as courses are added
+# Each query type is timed (best of three) with one query and with
+# WORKSPACE_QUERIES queries; the difference divided by the extra queries is the per-query
+# latency, without the cost of loading and saving the files.
+# WORKSPACE_ROWS sets the rows per course (default 20000).
+bench_workspace() {
+    local rows=${WORKSPACE_ROWS:-20000} queries=${WORKSPACE_QUERIES:-2000}
+    local courses i kind t1 tn
+
+    awk -v n="$queries" 'BEGIN {
+        for (i = 0; i < n; i++) print "stats HW " (i % 10 + 1) " --all"
+    }' > "$work/stats.txt"
+    awk -v n="$queries" 'BEGIN {
+        for (i = 0; i < n; i++) print "student " (1000000000 + i % 1000) " --all"
+    }' > "$work/student.txt"
+
+    for courses in 1 2 4 8 16; do
+        rm -rf "$work/courses"
+        mkdir -p "$work/courses"
+        for i in $(seq 1 "$courses"); do
+            ./gen_data.sh "$rows" 50 1000 "$i" > "$work/courses/c$i.txt"
+        done
+
+        for kind in stats student; do
+            head -n 1 "$work/$kind.txt" > "$work/one.txt"
+            t1=$(best_seconds "$work/one.txt" /dev/null "$GRADES" "$work"/courses/c*.txt)
+            tn=$(best_seconds "$work/$kind.txt" /dev/null "$GRADES" "$work"/courses/c*.txt)
+            awk -v c="$courses" -v rows="$rows" -v kind="$kind" -v t1="$t1" -v tn="$tn" \
+                -v q="$queries" 'BEGIN {
+                printf "workspace: %2d courses x %d rows, %-7s --all: %.3f ms/query\n",
+                       c, rows, kind, (tn - t1) * 1000 / (q - 1)
+            }'
+        done
+    done
+}
+
+# Streaming mode throughput on files several times the memory cap
+# The first command also builds the duplicate index (an external sort),
+# so it is reported separately from later full scans. STREAM_MEM sets the
+# cap (default 16M) and STREAM_SIZES the file sizes in MB (default 64 256).
+# "stats *" covers every row, so its mean also checks the sum for overflow.
+bench_stream() {
+    local mem=${STREAM_MEM:-16M} scans=3
+    local size rows bytes t1 tn mean i
+
+    printf 'stats *\n' > "$work/one.txt"
+    for i in $(seq 0 "$scans"); do
+        printf 'stats *\n'
+    done > "$work/scans.txt"
+
+    for size in ${STREAM_SIZES:-64 256}; do
+        # Generated rows average 21 bytes
+        rows=$((size * 1048576 / 21))
+        ./gen_data.sh "$rows" 50 100000 1 > "$work/stream.txt"
+        bytes=$(wc -c < "$work/stream.txt")
+
+        t1=$(seconds "$work/one.txt" "$work/stream.out" \
+                "$GRADES" --stream --mem-limit "$mem" "$work/stream.txt")
+        tn=$(seconds "$work/scans.txt" /dev/null \
+                "$GRADES" --stream --mem-limit "$mem" "$work/stream.txt")
+        mean=$(grep Mean "$work/stream.out")
+        awk -v mb="$((bytes / 1048576))" -v rows="$rows" -v mem="$mem" -v t1="$t1" \
+            -v tn="$tn" -v scans="$scans" -v mean="$mean" 'BEGIN {
+            printf "stream: %d MB (%d rows), cap %s: first command %.1f MB/s (%.2fs), " \
+                   "scan %.1f MB/s (%.2fs), %s\n", mb, rows, mem, mb / t1, t1,
+                   mb * scans / (tn - t1), (tn - t1) / scans, mean
+        }'
+        rm -f "$work/stream.txt"
+    done
+}
+
+# Print the milliseconds per command of a script, less the time of a script
+# with only its first line (loading, saving and building indexes)
+# The first line must not change the database
+# Usage: per_command SCRIPT COMMAND [ARGS...]
+per_command() {
+    local script=$1 n t1 tn
+    shift
+    n=$(wc -l < "$script")
+    head -n 1 "$script" > "$work/first.txt"
+    t1=$(best_seconds "$work/first.txt" /dev/null "$@")
+    tn=$(best_seconds "$script" /dev/null "$@")
+    awk -v t1="$t1" -v tn="$tn" -v n="$n" 'BEGIN { printf "%.4f", (tn - t1) * 1000 / (n - 1) }'
+}
+
+# Assignment index lookups with many assignments and a large table
+# INDEX_ROWS rows (default 50000) over INDEX_ASSIGNMENTS assignments
+# (default 5000). Loading, exact stats and add/remove pairs are also timed
+# with GRADES_BASE, an older build to compare against, if it is set.
+# Pattern queries are compared with streaming mode, which checks every row.
+bench_index() {
+    local rows=${INDEX_ROWS:-50000} assignments=${INDEX_ASSIGNMENTS:-5000}
+    local queries=${INDEX_QUERIES:-20000}
+    local kind
+
+    # Scripts of one kind of command each; names follow gen_data.sh
+    local kinds="exact addremove pattern prefix"
+    for kind in $kinds; do
+        awk -v n="$queries" -v kind="$kind" -v assignments="$assignments" '
+        BEGIN {
+            srand(3)
+            families = split("HW Lab Quiz Project Exam", family, " ")
+            print "stats HW 1"  # Read-only first line for per_command
+            for (i = 0; i < n; i++) {
+                a = int(rand() * assignments)
+                name = family[a % families + 1] " " (int(a / families) + 1)
+                if (kind == "exact") {
+                    print "stats " name
+                } else if (kind == "addremove") {
+                    print "add 9999999999:" name ":50"
+                    print "remove 9999999999:" name
+                } else if (kind == "pattern") {
+                    print "stats " family[a % families + 1] " " (a % 9 + 1) "?"
+                } else {
+                    print "assignments " family[a % families + 1] " " (a % 9 + 1) "0"
+                }
+            }
+        }' > "$work/$kind.txt"
+    done
+    head -n 21 "$work/pattern.txt" > "$work/stream_pattern.txt"
+
+    ./gen_data.sh "$rows" "$assignments" 1000 1 > "$work/index.txt"
+    head -n 1 "$work/exact.txt" > "$work/load.txt"
+    echo "index: $rows rows, $assignments assignments"
+    echo "index:   load and save: $(best_seconds "$work/load.txt" /dev/null "$GRADES" "$work/index.txt")s"
+    if [ -n "$GRADES_BASE" ]; then
+        echo "index:   load and save (GRADES_BASE): $(best_seconds "$work/load.txt" /dev/null \
+                "$GRADES_BASE" "$work/index.txt")s"
+    fi
+    for kind in $kinds; do
+        echo "index:   $kind: $(per_command "$work/$kind.txt" "$GRADES" "$work/index.txt") ms/command"
+        if [ -n "$GRADES_BASE" ] && { [ $kind = exact ] || [ $kind = addremove ]; }; then
+            echo "index:   $kind (GRADES_BASE): $(per_command "$work/$kind.txt" "$GRADES_BASE" "$work/index.txt") ms/command"
+        fi
+    done
+    echo "index:   pattern (streaming): $(per_command "$work/stream_pattern.txt" \
+            "$GRADES" --stream "$work/index.txt") ms/command"
+}
+
+case "${1:-all}" in
+    workspace) bench_workspace ;;
+    stream)    bench_stream ;;
+    pipeline)  bench_pipeline ;;
+    index)     bench_index ;;
+    all)       bench_workspace && bench_stream && bench_pipeline && bench_index ;;
+    *)         echo "Usage: $0 [workspace|stream|pipeline|index|all]" >&2; exit 1 ;;
+esac
@@ -3,20 +3,214 @@
 #include <string.h>
 #include "grades.h"
 
-// Print all grade entries in a formatted table
-void cmd_print(GradeList *list) {
+// Stream command output is written to, NULL for stdout
+static FILE *command_output = NULL;
+
+// Send command output to the given stream (NULL restores stdout)
+void set_command_output(FILE *stream) {
+    command_output = stream;
+}
+
+// Get the stream command output is written to
+FILE* command_stream(void) {
+    return command_output ? command_output : stdout;
+}
+
+// Print the header of the grade table
+void print_table_header(void) {
     // Print table header with proper column widths
-    printf("%-10s | %-20s | %5s\n", "Student ID", "Assignment Name", "Grade");
-    printf("-----------------------------------------\n");
+    fprintf(command_stream(), "%-10s | %-20s | %5s\n", "Student ID", "Assignment Name", "Grade");
+    fprintf(command_stream(), "-----------------------------------------\n");
+}
+
+// Print one row of the grade table
+void print_table_row(const struct GradeEntry *entry) {
+    fprintf(command_stream(), "%-10s | %-20s | %5hu\n", entry->studentId, entry->assignmentName, entry->grade);
+}
+
+// First entries of the assignments matched by a print pattern
+typedef struct {
+    Node **heads;              // Min-heap of chain positions, by order
+    int count;                 // Number of chains in the heap
+    int capacity;              // Allocated size of heads
+    bool failed;               // Ran out of memory while collecting
+} ChainHeap;
+
+// Add one assignment's entries to the heap (AssignmentFunc for cmd_print)
+static void collect_chain(const char *name, TrieNode *node, void *arg) {
+    ChainHeap *heap = arg;
+    (void)name;
+    
+    if (heap->failed) {
+        return;
+    }
+    
+    // Grow the array if needed
+    if (heap->count == heap->capacity) {
+        int capacity = heap->capacity ? heap->capacity * 2 : 16;
+        Node **grown = realloc(heap->heads, capacity * sizeof(Node *));
+        if (!grown) {
+            heap->failed = true;
+            return;
+        }
+        heap->heads = grown;
+        heap->capacity = capacity;
+    }
+    
+    heap->heads[heap->count++] = node->first;
+}
+
+// Move the chain at index i down until the heap is ordered again
+static void sift_down(ChainHeap *heap, int i) {
+    while (true) {
+        int smallest = i;
+        int left = 2 * i + 1;
+        int right = left + 1;
+        
+        if (left < heap->count && heap->heads[left]->order < heap->heads[smallest]->order) {
+            smallest = left;
+        }
+        if (right < heap->count && heap->heads[right]->order < heap->heads[smallest]->order) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            return;
+        }
+        
+        Node *tmp = heap->heads[i];
+        heap->heads[i] = heap->heads[smallest];
+        heap->heads[smallest] = tmp;
+        i = smallest;
+    }
+}
+
+// Print entries of every assignment matching pattern, in list order
+// Each matching assignment's entries are already in list order, so the
+// chains are merged by insertion order instead of scanning the list
+static void print_matching(GradeList *list, const char *pattern) {
+    ChainHeap heap = { NULL, 0, 0, false };
+    visit_assignments(list, pattern, collect_chain, &heap);
+    
+    if (heap.failed) {
+        // Out of memory - fall back to checking every entry
+        free(heap.heads);
+        for (Node *current = list->head; current; current = current->next) {
+            if (match_pattern(pattern, current->entry.assignmentName)) {
+                print_table_row(&current->entry);
+            }
+        }
+        return;
+    }
+    
+    // Build the heap, then repeatedly print the earliest entry
+    for (int i = heap.count / 2 - 1; i >= 0; i--) {
+        sift_down(&heap, i);
+    }
+    
+    while (heap.count > 0) {
+        Node *current = heap.heads[0];
+        print_table_row(&current->entry);
+        
+        // Advance this chain, or drop it if it is finished
+        if (current->next_same) {
+            heap.heads[0] = current->next_same;
+        } else {
+            heap.heads[0] = heap.heads[--heap.count];
+        }
+        sift_down(&heap, 0);
+    }
+    
+    free(heap.heads);
+}
+
+// Print grade entries in a formatted table
+// If pattern is not NULL, only entries for matching assignments are printed
+void cmd_print(GradeList *list, const char *pattern) {
+    print_table_header();
+    
+    if (pattern) {
+        print_matching(list, pattern);
+        return;
+    }
     
     // Print each entry
     Node *current = list->head;
     while (current) {
-        printf("%-10s | %-20s | %5hu\n", current->entry.studentId, current->entry.assignmentName, current->entry.grade);
+        print_table_row(&current->entry);
         current = current->next;
     }
 }
 
+// Add every grade of one assignment to the statistics (AssignmentFunc)
+static void add_assignment_stats(const char *name, TrieNode *node, void *arg) {
+    struct GradeStats *stats = arg;
+    (void)name;
+    
+    for (Node *current = node->first; current; current = current->next_same) {
+        int grade = current->entry.grade;
+        
+        // Update statistics
+        stats->sum += grade;
+        stats->count++;
+        
+        if (grade < stats->min) {
+            stats->min = grade;
+        }
+
+        if (grade > stats->max) {
+            stats->max = grade;
+        }
+    }
+}
+
+// Accumulate min, max, sum and count over every assignment matching pattern
+// Returns false if no grades were found
+bool compute_stats(GradeList *list, const char *pattern, struct GradeStats *stats) {
+    if (!list || !pattern || !stats) {
+        return false;
+    }
+    
+    stats->count = 0;
+    stats->sum = 0;
+    stats->min = 101;  // Start higher than max possible grade
+    stats->max = -1;   // Start lower than min possible grade
+    
+    // Only the matching assignments' entries are visited
+    visit_assignments(list, pattern, add_assignment_stats, stats);
+    
+    return stats->count > 0;
+}
+
+// Fold the statistics in src into dest
+void merge_stats(struct GradeStats *dest, const struct GradeStats *src) {
+    if (!dest || !src || src->count == 0) {
+        return;
+    }
+    
+    dest->sum += src->sum;
+    dest->count += src->count;
+    
+    if (src->min < dest->min) {
+        dest->min = src->min;
+    }
+
+    if (src->max > dest->max) {
+        dest->max = src->max;
+    }
+}
+
+// Print statistics in the standard format
+void print_stats(const char *label, const struct GradeStats *stats) {
+    // Calculate mean
+    double mean = (double)stats->sum / stats->count;
+    
+    // Print statistics
+    fprintf(command_stream(), "Grade statistics for %s\n", label);
+    fprintf(command_stream(), "Min: %d\n", stats->min);
+    fprintf(command_stream(), "Max: %d\n", stats->max);
+    fprintf(command_stream(), "Mean: %.2f\n", mean);
+}
+
 // Calculate and print statistics for a specific assignment
 void cmd_stats(GradeList *list, const char *assignment) {
     if (!list || !assignment) {
@@ -24,55 +218,79 @@ void cmd_stats(GradeList *list, const char *assignment) {
     }
     
     // Find all grades for this assignment
-    int count = 0;
-    int sum = 0;
-    int min = 101;  // Start higher than max possible grade
-    int max = -1;   // Start lower than min possible grade
+    struct GradeStats stats;
+    if (!compute_stats(list, assignment, &stats)) {
+        fprintf(command_stream(), "Error: No grades found for assignment '%s'\n", assignment);
+        return;
+    }
     
+    print_stats(assignment, &stats);
+}
+
+// Print one row of the assignment table (AssignmentFunc for cmd_assignments)
+static void print_assignment_row(const char *name, TrieNode *node, void *arg) {
+    (void)arg;
+    fprintf(command_stream(), "%-20s | %5d\n", name, node->count);
+}
+
+// List assignments whose name starts with prefix (or matches it, if it
+// contains wildcards), with the number of entries for each
+void cmd_assignments(GradeList *list, const char *prefix) {
+    if (!list) {
+        return;
+    }
+    
+    // Turn a plain prefix into a pattern; a trailing lone backslash is
+    // a literal one, so it has to be escaped before adding the '*'
+    char pattern[44];
+    if (!has_wildcard(prefix)) {
+        size_t slashes = 0;
+        for (size_t i = strlen(prefix); i > 0 && prefix[i - 1] == '\\'; i--) {
+            slashes++;
+        }
+        snprintf(pattern, sizeof(pattern), "%s%s*", prefix, slashes % 2 ? "\\" : "");
+    } else {
+        snprintf(pattern, sizeof(pattern), "%s", prefix);
+    }
+    
+    fprintf(command_stream(), "%-20s | %5s\n", "Assignment Name", "Count");
+    fprintf(command_stream(), "----------------------------\n");
+    visit_assignments(list, pattern, print_assignment_row, NULL);
+}
+
+// Print one row of a student's grade table, with the header before the first row
+void print_student_row(const struct GradeEntry *entry, int row) {
+    if (row == 0) {
+        fprintf(command_stream(), "%-20s | %5s\n", "Assignment Name", "Grade");
+        fprintf(command_stream(), "----------------------------\n");
+    }
+    fprintf(command_stream(), "%-20s | %5hu\n", entry->assignmentName, entry->grade);
+}
+
+// Print all grades recorded for a specific student
+void cmd_student(GradeList *list, const char *student_id) {
+    if (!list || !student_id) {
+        return;
+    }
+    
+    int count = 0;
     Node *current = list->head;
     while (current) {
-        // Check if this entry matches the assignment name
-        if (strcmp(current->entry.assignmentName, assignment) == 0) {
-            int grade = current->entry.grade;
-            
-            // Update statistics
-            sum += grade;
+        if (strcmp(current->entry.studentId, student_id) == 0) {
+            print_student_row(&current->entry, count);
             count++;
-            
-            if (grade < min) {
-                min = grade;
-            }
-
-            if (grade > max) {
-                max = grade;
-            }
         }
         current = current->next;
     }
     
-    // Check if any entries were found
     if (count == 0) {
-        printf("Error: No grades found for assignment '%s'\n", assignment);
-        return;
+        fprintf(command_stream(), "Error: No grades found for student '%s'\n", student_id);
     }
-    
-    // Calculate mean
-    double mean = (double)sum / count;
-    
-    // Print statistics
-    printf("Grade statistics for %s\n", assignment);
-    printf("Min: %d\n", min);
-    printf("Max: %d\n", max);
-    printf("Mean: %.2f\n", mean);
 }
 
-// Process the add command
-void cmd_add(GradeList *list, const char *args) {
-    if (!list || !args) {
-        printf("Error: Invalid argument\n");
-        return;
-    }
-    
+// Parse the arguments of the add command into cmd
+// Returns false if the arguments are invalid
+static bool parse_add(const char *args, Command *cmd) {
     // Skip any leading whitespace in args
     while (*args == ' ' || *args == '\t') {
         args++;
@@ -80,109 +298,101 @@ void cmd_add(GradeList *list, const char *args) {
     
     // Check if args is empty after skipping whitespace
     if (*args == '\0') {
-        printf("Error: Invalid argument\n");
-        return;
+        return false;
     }
     
     // Parse: STUDENT_ID:ASSIGNMENT_NAME:GRADE
-    char student_id[11];
-    char assignment[21];
     char grade_str[10];
     
     // Find first colon
     const char *first_colon = strchr(args, ':');
     if (!first_colon) {
-        printf("Error: Invalid argument\n");
-        return;
+        return false;
     }
     
     // Find second colon
     const char *second_colon = strchr(first_colon + 1, ':');
     if (!second_colon) {
-        printf("Error: Invalid argument\n");
-        return;
+        return false;
     }
     
     // Extract student ID
     int id_len = first_colon - args;
     if (id_len > 10 || id_len == 0) {
-        printf("Error: Invalid argument\n");
-        return;
+        return false;
     }
-    strncpy(student_id, args, id_len);
-    student_id[id_len] = '\0';
+    strncpy(cmd->studentId, args, id_len);
+    cmd->studentId[id_len] = '\0';
     
     // Extract assignment name
     int name_len = second_colon - first_colon - 1;
     if (name_len > 20 || name_len == 0) {
-        printf("Error: Invalid argument\n");
-        return;
+        return false;
     }
-    strncpy(assignment, first_colon + 1, name_len);
-    assignment[name_len] = '\0';
+    strncpy(cmd->assignmentName, first_colon + 1, name_len);
+    cmd->assignmentName[name_len] = '\0';
     
     // Extract grade string
     strncpy(grade_str, second_colon + 1, sizeof(grade_str) - 1);
     grade_str[sizeof(grade_str) - 1] = '\0';
     
     // Validate inputs
-    unsigned short grade;
-    if (!is_valid_student_id(student_id) || !is_valid_assignment_name(assignment) || !is_valid_grade(grade_str, &grade)) {
-        printf("Error: Invalid argument\n");
-        return;
-    }
-    
-    // Try to add the entry
-    if (!add_entry(list, student_id, assignment, grade)) {
-        printf("Error: Entry already exists\n");
-    }
+    return is_valid_student_id(cmd->studentId) &&
+           is_valid_assignment_name(cmd->assignmentName) &&
+           is_valid_grade(grade_str, &cmd->grade);
 }
 
-// Process the remove command
-void cmd_remove(GradeList *list, const char *args) {
-    if (!list || !args) {
-        printf("Error: Invalid argument\n");
-        return;
-    }
-    
+// Parse the arguments of the remove command into cmd
+// Returns false if the arguments are invalid
+static bool parse_remove(const char *args, Command *cmd) {
     // Parse: STUDENT_ID:ASSIGNMENT_NAME
-    char student_id[11];
-    char assignment[21];
     
     // Find the colon
     const char *colon = strchr(args, ':');
     if (!colon) {
-        printf("Error: Invalid argument\n");
-        return;
+        return false;
     }
     
     // Extract student ID
     int id_len = colon - args;
     if (id_len > 10) {
-        printf("Error: Invalid argument\n");
-        return;
+        return false;
     }
-    strncpy(student_id, args, id_len);
-    student_id[id_len] = '\0';
+    strncpy(cmd->studentId, args, id_len);
+    cmd->studentId[id_len] = '\0';
     
     // Extract assignment name
-    strcpy(assignment, colon + 1);
+    if (strlen(colon + 1) > 20) {
+        return false;
+    }
+    strcpy(cmd->assignmentName, colon + 1);
     
     // Validate inputs
-    if (!is_valid_student_id(student_id) || !is_valid_assignment_name(assignment)) {
-        printf("Error: Invalid argument\n");
-        return;
+    return is_valid_student_id(cmd->studentId) && is_valid_assignment_name(cmd->assignmentName);
+}
+
+// Get the assignment filter of a print command, or NULL to print everything
+const char* print_filter(const char *line) {
+    if (line[5] != ' ') {
+        return NULL;
     }
     
-    // Try to remove the entry
-    if (!remove_entry(list, student_id, assignment)) {
-        printf("Error: Entry not found\n");
+    // Skip whitespace between "print" and the filter
+    const char *filter = line + 5;
+    while (*filter == ' ' || *filter == '\t') {
+        filter++;
     }
+    
+    return *filter == '\0' ? NULL : filter;
 }
 
-// Main command processor - determines which command to execute
-void process_command(char *line, GradeList *list) {
-    if (!line || !list) {
+// Parse one input line into cmd without executing it
+// Never prints; problems are recorded as CMD_INVALID or CMD_UNKNOWN
+void parse_command(const char *line, Command *cmd) {
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->type = CMD_NONE;
+    
+    if (!line) {
         return;
     }
     
@@ -198,28 +408,115 @@ void process_command(char *line, GradeList *list) {
     
     // Check which command was entered
     if (strncmp(line, "print", 5) == 0) {
-        // Print command - ignore any arguments
-        cmd_print(list);
+        // Print command - optional assignment name after "print "
+        const char *assignment = print_filter(line);
+        cmd->type = CMD_PRINT;
+        if (assignment && is_valid_assignment_pattern(assignment)) {
+            strcpy(cmd->assignmentName, assignment);
+        } else if (assignment) {
+            cmd->type = CMD_INVALID;
+        }
+    }
+    else if (strncmp(line, "assignments", 11) == 0 && (line[11] == ' ' || line[11] == '\0')) {
+        // Assignments command - optional name prefix after "assignments "
+        const char *prefix = line + 11;
+        while (*prefix == ' ' || *prefix == '\t') {
+            prefix++;
+        }
+        cmd->type = CMD_ASSIGNMENTS;
+        if (*prefix != '\0' && is_valid_assignment_pattern(prefix)) {
+            strcpy(cmd->assignmentName, prefix);
+        } else if (*prefix != '\0') {
+            cmd->type = CMD_INVALID;
+        }
     }
     else if (strncmp(line, "add ", 4) == 0) {
         // Add command - parse arguments after "add "
-        cmd_add(list, line + 4);
+        cmd->type = parse_add(line + 4, cmd) ? CMD_ADD : CMD_INVALID;
     }
     else if (strncmp(line, "remove ", 7) == 0) {
         // Remove command - parse arguments after "remove "
-        cmd_remove(list, line + 7);
+        cmd->type = parse_remove(line + 7, cmd) ? CMD_REMOVE : CMD_INVALID;
+    }
+    else if (strncmp(line, "student ", 8) == 0) {
+        // Student command - parse student ID after "student "
+        const char *student_id = line + 8;
+        cmd->type = CMD_INVALID;
+        if (is_valid_student_id(student_id)) {
+            strcpy(cmd->studentId, student_id);
+            cmd->type = CMD_STUDENT;
+        }
     }
     else if (strncmp(line, "stats ", 6) == 0) {
         // Stats command - parse assignment name after "stats "
         const char *assignment = line + 6;
-        if (is_valid_assignment_name(assignment)) {
-            cmd_stats(list, assignment);
-        } else {
-            printf("Error: Invalid argument\n");
+        cmd->type = CMD_INVALID;
+        if (is_valid_assignment_pattern(assignment)) {
+            strcpy(cmd->assignmentName, assignment);
+            cmd->type = CMD_STATS;
         }
     }
     else {
         // Unknown command
-        printf("Error: Unknown command\n");
+        cmd->type = CMD_UNKNOWN;
+    }
+}
+
+// Execute a parsed command against the list
+void execute_command(const Command *cmd, GradeList *list) {
+    if (!cmd || !list) {
+        return;
+    }
+    
+    switch (cmd->type) {
+    case CMD_NONE:
+        break;
+    case CMD_PRINT:
+        cmd_print(list, cmd->assignmentName[0] ? cmd->assignmentName : NULL);
+        break;
+    case CMD_ADD:
+        // Try to add the entry
+        if (!add_entry(list, cmd->studentId, cmd->assignmentName, cmd->grade)) {
+            fprintf(command_stream(), "Error: Entry already exists\n");
+        }
+        break;
+    case CMD_REMOVE:
+        // Try to remove the entry
+        if (!remove_entry(list, cmd->studentId, cmd->assignmentName)) {
+            fprintf(command_stream(), "Error: Entry not found\n");
+        }
+        break;
+    case CMD_STUDENT:
+        cmd_student(list, cmd->studentId);
+        break;
+    case CMD_STATS:
+        cmd_stats(list, cmd->assignmentName);
+        break;
+    case CMD_ASSIGNMENTS:
+        cmd_assignments(list, cmd->assignmentName);
+        break;
+    case CMD_INVALID:
+        fprintf(command_stream(), "Error: Invalid argument\n");
+        break;
+    case CMD_UNKNOWN:
+        fprintf(command_stream(), "Error: Unknown command\n");
+        break;
+    case CMD_USE:
+    case CMD_COURSES:
+    case CMD_STUDENT_ALL:
+    case CMD_STATS_ALL:
+        // Workspace commands are run by execute_workspace_command
+        break;
     }
-}
\ No newline at end of file
+}
+
+// Main command processor - parses and executes one line
+void process_command(char *line, GradeList *list) {
+    if (!line || !list) {
+        return;
+    }
+    
+    Command cmd;
+    parse_command(line, &cmd);
+    execute_command(&cmd, list);
+}
@@ -4,6 +4,92 @@
 #include <unistd.h>
 #include "grades.h"
 
+// Parse one database line (STUDENT_ID:ASSIGNMENT_NAME:GRADE) into entry
+// The line is trimmed in place; returns false for empty or invalid lines
+bool parse_entry_line(char *line, size_t read, struct GradeEntry *entry) {
+    if (!line || !entry) {
+        return false;
+    }
+    
+    // Remove ALL trailing whitespace including \r, \n, spaces, tabs
+    // To possibly handle for both Windows (\r\n) and Linux (\n) line endings
+    while (read > 0 && (line[read - 1] == '\n' || 
+                        line[read - 1] == '\r' || 
+                        line[read - 1] == ' ' || 
+                        line[read - 1] == '\t')) {
+        line[read - 1] = '\0';
+        read--;
+    }
+    
+    // Skip empty lines
+    if (read == 0 || line[0] == '\0') {
+        return false;
+    }
+    
+    // Parse the line: STUDENT_ID:ASSIGNMENT_NAME:GRADE
+    char student_id[12] = {0};
+    char assignment[22] = {0};
+    char grade_str[12] = {0};
+    
+    // Find first colon
+    char *first_colon = strchr(line, ':');
+    if (!first_colon) {
+        return false;
+    }
+    
+    // Find second colon
+    char *second_colon = strchr(first_colon + 1, ':');
+    if (!second_colon) {
+        return false;
+    }
+    
+    // Extract student ID (before first colon)
+    int id_len = first_colon - line;
+    if (id_len > 10 || id_len <= 0) {
+        return false;
+    }
+    strncpy(student_id, line, id_len);
+    student_id[id_len] = '\0';
+    
+    // Extract assignment name (between colons)
+    int name_len = second_colon - first_colon - 1;
+    if (name_len > 20 || name_len <= 0) {
+        return false;
+    }
+    strncpy(assignment, first_colon + 1, name_len);
+    assignment[name_len] = '\0';
+    
+    // Extract grade (after second colon)
+    strncpy(grade_str, second_colon + 1, sizeof(grade_str) - 1);
+    grade_str[sizeof(grade_str) - 1] = '\0';
+    
+    // Remove any trailing whitespace from grade string
+    // (in case there are spaces or \r characters)
+    size_t grade_len = strlen(grade_str);
+    while (grade_len > 0 && (grade_str[grade_len - 1] == ' ' || 
+                              grade_str[grade_len - 1] == '\t' ||
+                              grade_str[grade_len - 1] == '\n' ||
+                              grade_str[grade_len - 1] == '\r')) {
+        grade_str[grade_len - 1] = '\0';
+        grade_len--;
+    }
+    
+    // Validate and convert grade
+    unsigned short grade;
+    if (!is_valid_student_id(student_id) ||
+        !is_valid_assignment_name(assignment) ||
+        !is_valid_grade(grade_str, &grade)) {
+        return false;  // Skip invalid entries
+    }
+    
+    // Fill in the entry
+    memset(entry, 0, sizeof(*entry));
+    strcpy(entry->studentId, student_id);
+    strcpy(entry->assignmentName, assignment);
+    entry->grade = grade;
+    return true;
+}
+
 // Load grade entries from database file into linked list
 bool load_database(const char *filename, GradeList *list) {
     if (!filename || !list) {
@@ -22,79 +108,14 @@ bool load_database(const char *filename, GradeList *list) {
     
     // Read each line from the file
     while ((read = getline(&line, &len, file)) != -1) {
-        // Remove ALL trailing whitespace including \r, \n, spaces, tabs
-        // To possibly handle for both Windows (\r\n) and Linux (\n) line endings
-        while (read > 0 && (line[read - 1] == '\n' || 
-                            line[read - 1] == '\r' || 
-                            line[read - 1] == ' ' || 
-                            line[read - 1] == '\t')) {
-            line[read - 1] = '\0';
-            read--;
-        }
-        
-        // Skip empty lines
-        if (read == 0 || line[0] == '\0') {
-            continue;
-        }
-        
-        // Parse the line: STUDENT_ID:ASSIGNMENT_NAME:GRADE
-        char student_id[12] = {0};
-        char assignment[22] = {0};
-        char grade_str[12] = {0};
-        
-        // Find first colon
-        char *first_colon = strchr(line, ':');
-        if (!first_colon) {
-            continue;
-        }
-        
-        // Find second colon
-        char *second_colon = strchr(first_colon + 1, ':');
-        if (!second_colon) {
-            continue;
-        }
-        
-        // Extract student ID (before first colon)
-        int id_len = first_colon - line;
-        if (id_len > 10 || id_len <= 0) {
-            continue;
-        }
-        strncpy(student_id, line, id_len);
-        student_id[id_len] = '\0';
-        
-        // Extract assignment name (between colons)
-        int name_len = second_colon - first_colon - 1;
-        if (name_len > 20 || name_len <= 0) {
+        // Parse the line, skipping empty and invalid entries
+        struct GradeEntry entry;
+        if (!parse_entry_line(line, read, &entry)) {
             continue;
         }
-        strncpy(assignment, first_colon + 1, name_len);
-        assignment[name_len] = '\0';
-        
-        // Extract grade (after second colon)
-        strncpy(grade_str, second_colon + 1, sizeof(grade_str) - 1);
-        grade_str[sizeof(grade_str) - 1] = '\0';
-        
-        // Remove any trailing whitespace from grade string
-        // (in case there are spaces or \r characters)
-        size_t grade_len = strlen(grade_str);
-        while (grade_len > 0 && (grade_str[grade_len - 1] == ' ' || 
-                                  grade_str[grade_len - 1] == '\t' ||
-                                  grade_str[grade_len - 1] == '\n' ||
-                                  grade_str[grade_len - 1] == '\r')) {
-            grade_str[grade_len - 1] = '\0';
-            grade_len--;
-        }
-        
-        // Validate and convert grade
-        unsigned short grade;
-        if (!is_valid_student_id(student_id) ||
-            !is_valid_assignment_name(assignment) ||
-            !is_valid_grade(grade_str, &grade)) {
-            continue;  // Skip invalid entries
-        }
         
         // Add the entry to the list
-        add_entry(list, student_id, assignment, grade);
+        add_entry(list, entry.studentId, entry.assignmentName, entry.grade);
     }
     
     // Clean up
@@ -0,0 +1,23 @@
+#!/bin/bash
+# Generate a random grades database on stdout
+# Usage: ./gen_data.sh ROWS [ASSIGNMENTS] [STUDENTS] [SEED]
+#
+# Assignment names come in families like sample.txt ("HW 1", "Lab 2", ...),
+# student IDs are 10 digits starting at 1000000000. Random pairs can repeat,
+# so the file also contains some duplicate entries.
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 ROWS [ASSIGNMENTS] [STUDENTS] [SEED]" >&2
+    exit 1
+fi
+
+awk -v rows="$1" -v assignments="${2:-13}" -v students="${3:-1000}" -v seed="${4:-1}" '
+BEGIN {
+    srand(seed)
+    families = split("HW Lab Quiz Project Exam", family, " ")
+    for (i = 0; i < rows; i++) {
+        a = int(rand() * assignments)
+        printf "%d:%s %d:%d\n", 1000000000 + int(rand() * students),
+               family[a % families + 1], int(a / families) + 1, int(rand() * 101)
+    }
+}'
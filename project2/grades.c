@@ -17,39 +17,102 @@ bool can_read_write(char *filename) {
     return (access(filename, R_OK | W_OK) == 0);
 }
 
-int main(int argc, char *argv[]) {
-    // Check that exactly one argument (database file path) was provided
-    if (argc != 2) {
-        fprintf(stderr, "Usage: %s DATABASE_FILE\n", argv[0]);
-        return 1;
-    }
+// Check if file has read permission
+bool can_read(char *filename) {
+    return (access(filename, R_OK) == 0);
+}
 
-    char *db_file = argv[1];
+// Print the command-line usage message
+void print_usage(const char *program) {
+    fprintf(stderr, "Usage: %s DATABASE_FILE [DATABASE_FILE...]\n", program);
+    fprintf(stderr, "       %s --stream [--mem-limit SIZE] DATABASE_FILE\n", program);
+    fprintf(stderr, "       %s --pipeline DATABASE_FILE [DATABASE_FILE...]\n", program);
+}
 
-    // Verify the database file exists
-    if (!file_exists(db_file)) {
-        fprintf(stderr, "Error: File '%s' does not exist\n", db_file);
-        return 1;
+int main(int argc, char *argv[]) {
+    bool stream = false;
+    bool pipeline = false;
+    bool mem_limit_set = false;
+    size_t mem_limit = DEFAULT_MEM_LIMIT;
+
+    // Parse options, which come before the database files
+    int first_file = 1;
+    while (first_file < argc && strncmp(argv[first_file], "--", 2) == 0) {
+        if (strcmp(argv[first_file], "--stream") == 0) {
+            stream = true;
+        }
+        else if (strcmp(argv[first_file], "--pipeline") == 0) {
+            pipeline = true;
+        }
+        else if (strcmp(argv[first_file], "--mem-limit") == 0 && first_file + 1 < argc) {
+            first_file++;
+            if (!is_valid_mem_limit(argv[first_file], &mem_limit)) {
+                fprintf(stderr, "Error: Invalid memory limit '%s'\n", argv[first_file]);
+                return 1;
+            }
+            mem_limit_set = true;
+        }
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+        first_file++;
     }
 
-    // Verify we can read and write to the file
-    if (!can_read_write(db_file)) {
-        fprintf(stderr, "Error: Cannot read/write file '%s'\n", db_file);
+    // Check that at least one database file was provided, and exactly one
+    // in streaming mode. The memory limit only applies to streaming mode,
+    // and streaming and pipelined mode cannot be combined.
+    int file_count = argc - first_file;
+    if (file_count < 1 || (stream && file_count != 1) ||
+        (mem_limit_set && !stream) || (stream && pipeline)) {
+        print_usage(argv[0]);
         return 1;
     }
 
-    // Create an empty linked list to store grade entries
-    GradeList *list = create_list();
-    if (!list) {
-        fprintf(stderr, "Error: Failed to create list\n");
-        return 1;
+    // Verify every database file exists and can be accessed
+    // Streaming mode never writes, so it only needs read permission
+    for (int i = first_file; i < argc; i++) {
+        if (!file_exists(argv[i])) {
+            fprintf(stderr, "Error: File '%s' does not exist\n", argv[i]);
+            return 1;
+        }
+
+        if (stream && !can_read(argv[i])) {
+            fprintf(stderr, "Error: Cannot read file '%s'\n", argv[i]);
+            return 1;
+        }
+
+        if (!stream && !can_read_write(argv[i])) {
+            fprintf(stderr, "Error: Cannot read/write file '%s'\n", argv[i]);
+            return 1;
+        }
     }
 
-    // Load the database file into the linked list
-    if (!load_database(db_file, list)) {
-        fprintf(stderr, "Error: Failed to load database\n");
-        free_list(list);
-        return 1;
+    Workspace *ws = NULL;
+    StreamDb *db = NULL;
+
+    if (stream) {
+        // Read the database straight from its file, in bounded memory
+        db = create_stream_db(argv[first_file], mem_limit);
+        if (!db) {
+            fprintf(stderr, "Error: Failed to open database\n");
+            return 1;
+        }
+    } else {
+        // Create a workspace with one course per database file
+        ws = create_workspace(argv + first_file, file_count);
+        if (!ws) {
+            fprintf(stderr, "Error: Failed to create workspace\n");
+            return 1;
+        }
+
+        // With a single database, load it up front so a bad file is reported
+        // before any command runs. Extra courses are loaded on first use.
+        if (ws->count == 1 && !course_list(&ws->courses[0])) {
+            fprintf(stderr, "Error: Failed to load database\n");
+            free_workspace(ws);
+            return 1;
+        }
     }
 
     // Buffer to store each line of user input
@@ -57,8 +120,21 @@ int main(int argc, char *argv[]) {
     size_t len = 0;
     ssize_t read;
 
+    // Pipelined mode reads, executes and prints on separate threads.
+    // If its threads cannot start, fall through to the normal loop.
+    bool failed = false;
+    bool done = pipeline && run_pipeline(ws, &failed);
+
+    // A pipeline that stopped early may have skipped commands, so keep
+    // the database file as it was
+    if (failed) {
+        fprintf(stderr, "Error: Commands not completed, database not saved\n");
+        free_workspace(ws);
+        return 1;
+    }
+
     // Main command loop: read commands until EOF (Ctrl+D)
-    while ((read = getline(&line, &len, stdin)) != -1) {
+    while (!done && (read = getline(&line, &len, stdin)) != -1) {
         // Remove newline character at end of input
         if (read > 0 && line[read - 1] == '\n') {
             line[read - 1] = '\0';
@@ -66,20 +142,30 @@ int main(int argc, char *argv[]) {
         }
 
         // Process the command entered by user
-        process_command(line, list);
+        if (stream) {
+            process_stream_command(line, db);
+        } else {
+            process_workspace_command(line, ws);
+        }
     }
 
     // Free the input buffer
     free(line);
 
-    // Save the modified database back to file
-    if (!save_database(db_file, list)) {
+    // Streaming mode is read-only - nothing to save
+    if (stream) {
+        free_stream_db(db);
+        return 0;
+    }
+
+    // Save the modified databases back to their files
+    if (!save_workspace(ws)) {
         fprintf(stderr, "Error: Failed to save database\n");
-        free_list(list);
+        free_workspace(ws);
         return 1;
     }
 
     // Clean up: free all allocated memory
-    free_list(list);
+    free_workspace(ws);
     return 0;
 }
\ No newline at end of file
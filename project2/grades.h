@@ -1,7 +1,9 @@
 #ifndef GRADES_H
 #define GRADES_H
 
+#include <stdio.h>
 #include <stdbool.h>
+#include <pthread.h>
 
 // Structure to hold a single grade entry
 struct GradeEntry {
@@ -14,15 +16,136 @@ struct GradeEntry {
 typedef struct Node {
     struct GradeEntry entry;   // The grade entry data
     struct Node *next;         // Pointer to next node
+    struct Node *prev;         // Pointer to previous node
+    struct Node *next_same;    // Next entry for the same assignment
+    struct Node *prev_same;    // Previous entry for the same assignment
+    unsigned long order;       // Insertion order, increasing along the list
 } Node;
 
+// Node in the assignment name trie
+// Each node stands for the name spelled by the path from the root.
+// Children are kept in a sibling list sorted by character, so walking
+// the trie visits names in the same order as strcmp.
+typedef struct TrieNode {
+    unsigned char ch;          // Character on the edge into this node
+    struct TrieNode *child;    // First child
+    struct TrieNode *sibling;  // Next child of the same parent
+    Node *first;               // First entry for this assignment, NULL if none
+    Node *last;                // Last entry for this assignment
+    int count;                 // Number of entries for this assignment
+} TrieNode;
+
 // Linked list structure
 typedef struct {
     Node *head;                // Pointer to first node
     Node *tail;                // Pointer to last node
     int count;                 // Number of entries
+    TrieNode *index;           // Root of the assignment name trie
+    unsigned long next_order;  // Order given to the next added entry
 } GradeList;
 
+// Kinds of command understood by process_command
+typedef enum {
+    CMD_NONE,                  // Empty line
+    CMD_PRINT,
+    CMD_ADD,
+    CMD_REMOVE,
+    CMD_STUDENT,
+    CMD_STATS,
+    CMD_ASSIGNMENTS,
+    CMD_INVALID,               // Known command with bad arguments
+    CMD_UNKNOWN,               // Unrecognized command
+    CMD_USE,                   // Workspace: switch course
+    CMD_COURSES,               // Workspace: list courses
+    CMD_STUDENT_ALL,           // Workspace: student ID --all
+    CMD_STATS_ALL              // Workspace: stats NAME --all
+} CommandType;
+
+// Command parsed from one input line, ready to execute
+typedef struct {
+    CommandType type;          // Which command to run
+    char studentId[11];        // Student ID argument, if any
+    char assignmentName[41];   // Assignment name or pattern, empty if none
+    unsigned short grade;      // Grade argument of add
+    const char *courseName;    // Course argument of use
+} Command;
+
+// Running statistics for one assignment
+struct GradeStats {
+    long count;                // Number of grades seen
+    long long sum;             // Sum of all grades (large files overflow int)
+    int min;                   // Lowest grade
+    int max;                   // Highest grade
+};
+
+// Called for each assignment matched by a pattern
+typedef void (*AssignmentFunc)(const char *name, TrieNode *node, void *arg);
+
+// Task run by the thread pool, called once per task index
+typedef void (*TaskFunc)(void *arg, int index);
+
+// Fixed set of worker threads that run batches of indexed tasks
+typedef struct {
+    pthread_t *threads;        // Worker threads
+    int thread_count;          // Number of worker threads
+    pthread_mutex_t lock;      // Protects all fields below
+    pthread_cond_t work_ready; // Signalled when a batch is posted
+    pthread_cond_t work_done;  // Signalled when a batch finishes
+    TaskFunc func;             // Task function for current batch
+    void *arg;                 // Argument passed to every task
+    int next_task;             // Next task index to hand out
+    int task_count;            // Number of tasks in current batch
+    int pending;               // Tasks not yet finished
+    bool shutdown;             // Tells workers to exit
+} ThreadPool;
+
+// One course database in a workspace
+typedef struct {
+    char *name;                // Course name (file name without extension)
+    char *filename;            // Path to the database file
+    GradeList *list;           // Loaded entries, NULL until first use
+} Course;
+
+// Set of course databases open at once
+typedef struct {
+    Course *courses;           // Array of courses
+    int count;                 // Number of courses
+    int current;               // Index of course selected with 'use'
+    ThreadPool *pool;          // Workers for cross-course queries
+} Workspace;
+
+// Single-producer/single-consumer ring of pointers
+// head and tail are kept on separate cache lines so the two threads
+// do not invalidate each other's line on every push and pop.
+// A side that finds the ring empty (or full) spins briefly, then sleeps
+// on a condition variable until the other side wakes it.
+typedef struct {
+    void **slots;              // Ring storage
+    size_t mask;               // Capacity - 1 (capacity is a power of two)
+    char pad1[64];
+    size_t head;               // Next slot to pop, written by the consumer
+    char pad2[64];
+    size_t tail;               // Next slot to push, written by the producer
+    char pad3[64];
+    pthread_mutex_t lock;      // Only taken to sleep or to wake a sleeper
+    pthread_cond_t not_empty;  // Consumer sleeps here while the ring is empty
+    pthread_cond_t not_full;   // Producer sleeps here while the ring is full
+    int consumer_waiting;      // Consumer is (about to be) asleep
+    int producer_waiting;      // Producer is (about to be) asleep
+} SpscRing;
+
+// Default and minimum memory cap for streaming mode, in bytes
+#define DEFAULT_MEM_LIMIT (64UL * 1024 * 1024)
+#define MIN_MEM_LIMIT (64UL * 1024)
+
+// Database read directly from its file instead of being loaded into a list
+typedef struct {
+    char *filename;            // Path to the database file
+    size_t mem_limit;          // Memory cap for sorting, in bytes
+    FILE *duplicates;          // Sorted line numbers of duplicate entries, NULL until built
+    long duplicate_count;      // Number of line numbers in duplicates
+} StreamDb;
+
 // Function declarations
 
 // List management functions
@@ -31,18 +154,71 @@ void free_list(GradeList *list);
 bool add_entry(GradeList *list, const char *student_id,  const char *assignment, unsigned short grade);
 bool remove_entry(GradeList *list, const char *student_id, const char *assignment);
 
+// Assignment index functions
+TrieNode* index_find(TrieNode *root, const char *name, bool create);
+void free_index(TrieNode *root);
+void visit_assignments(GradeList *list, const char *pattern, AssignmentFunc func, void *arg);
+bool match_pattern(const char *pattern, const char *name);
+bool has_wildcard(const char *pattern);
+int pattern_length(const char *pattern);
+
 // Database I/O functions
 bool load_database(const char *filename, GradeList *list);
 bool save_database(const char *filename, GradeList *list);
+bool parse_entry_line(char *line, size_t read, struct GradeEntry *entry);
 
 // Command processing
 void process_command(char *line, GradeList *list);
-void cmd_print(GradeList *list);
+void parse_command(const char *line, Command *cmd);
+void execute_command(const Command *cmd, GradeList *list);
+void set_command_output(FILE *stream);
+FILE* command_stream(void);
+void cmd_print(GradeList *list, const char *assignment);
+const char* print_filter(const char *line);
+void print_table_header(void);
+void print_table_row(const struct GradeEntry *entry);
+void print_student_row(const struct GradeEntry *entry, int row);
 void cmd_stats(GradeList *list, const char *assignment);
+void cmd_student(GradeList *list, const char *student_id);
+void cmd_assignments(GradeList *list, const char *prefix);
+bool compute_stats(GradeList *list, const char *assignment, struct GradeStats *stats);
+void merge_stats(struct GradeStats *dest, const struct GradeStats *src);
+void print_stats(const char *label, const struct GradeStats *stats);
+
+// Lock-free ring functions
+SpscRing* create_ring(size_t capacity);
+void free_ring(SpscRing *ring);
+void ring_push(SpscRing *ring, void *item);
+void* ring_pop(SpscRing *ring);
+bool ring_empty(SpscRing *ring);
+
+// Pipelined command execution
+bool run_pipeline(Workspace *ws, bool *failed);
+
+// Thread pool functions
+ThreadPool* create_pool(int thread_count);
+void pool_run(ThreadPool *pool, int task_count, TaskFunc func, void *arg);
+void free_pool(ThreadPool *pool);
+
+// Workspace functions
+Workspace* create_workspace(char **filenames, int count);
+void free_workspace(Workspace *ws);
+GradeList* course_list(Course *course);
+bool save_workspace(Workspace *ws);
+void process_workspace_command(char *line, Workspace *ws);
+void parse_workspace_command(const char *line, Command *cmd);
+void execute_workspace_command(const Command *cmd, Workspace *ws);
+
+// Streaming mode functions
+StreamDb* create_stream_db(const char *filename, size_t mem_limit);
+void free_stream_db(StreamDb *db);
+void process_stream_command(char *line, StreamDb *db);
 
 // Validation functions
 bool is_valid_student_id(const char *id);
 bool is_valid_assignment_name(const char *name);
+bool is_valid_assignment_pattern(const char *pattern);
 bool is_valid_grade(const char *grade_str, unsigned short *grade);
+bool is_valid_mem_limit(const char *limit_str, size_t *limit);
 
 #endif
\ No newline at end of file
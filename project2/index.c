@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "grades.h"
+
+// Find the trie node for an assignment name
+// With create set, missing nodes are added; otherwise NULL is returned
+TrieNode* index_find(TrieNode *root, const char *name, bool create) {
+    if (!root || !name) {
+        return NULL;
+    }
+
+    TrieNode *node = root;
+    for (const char *p = name; *p; p++) {
+        unsigned char c = *p;
+
+        // Children are sorted, so stop at the first one not below c
+        TrieNode **link = &node->child;
+        while (*link && (*link)->ch < c) {
+            link = &(*link)->sibling;
+        }
+
+        if (!*link || (*link)->ch != c) {
+            if (!create) {
+                return NULL;
+            }
+
+            // Insert a new child in sorted position
+            TrieNode *child = calloc(1, sizeof(TrieNode));
+            if (!child) {
+                return NULL;
+            }
+            child->ch = c;
+            child->sibling = *link;
+            *link = child;
+        }
+
+        node = *link;
+    }
+
+    return node;
+}
+
+// Free a trie node and everything below it
+// Nodes whose assignment lost all its entries are kept until the list is freed
+void free_index(TrieNode *root) {
+    while (root) {
+        TrieNode *sibling = root->sibling;  // Save sibling before freeing
+        free_index(root->child);            // Depth is at most 20
+        free(root);
+        root = sibling;
+    }
+}
+
+// Read one pattern character at pattern
+// Sets *ch and returns how many pattern characters it took, or returns 0
+// for a wildcard. '\*', '\?' and '\\' stand for the literal character;
+// any other backslash is an ordinary character.
+static int pattern_char(const char *pattern, char *ch) {
+    if (pattern[0] == '\\' && pattern[1] != '\0' && strchr("*?\\", pattern[1])) {
+        *ch = pattern[1];
+        return 2;
+    }
+
+    if (pattern[0] == '*' || pattern[0] == '?') {
+        return 0;
+    }
+
+    *ch = pattern[0];
+    return 1;
+}
+
+// Check if a pattern contains an unescaped '*' or '?'
+bool has_wildcard(const char *pattern) {
+    char ch;
+    while (*pattern) {
+        int used = pattern_char(pattern, &ch);
+        if (used == 0) {
+            return true;
+        }
+        pattern += used;
+    }
+    return false;
+}
+
+// Count the name characters a pattern stands for
+// Literal characters and '?' count one each; '*' counts zero
+int pattern_length(const char *pattern) {
+    int length = 0;
+    char ch;
+    while (*pattern) {
+        int used = pattern_char(pattern, &ch);
+        if (used > 0 || *pattern == '?') {
+            length++;
+        }
+        pattern += used > 0 ? used : 1;
+    }
+    return length;
+}
+
+// Check if an assignment name matches a pattern
+// '*' matches any run of characters and '?' matches exactly one;
+// a backslash before either makes it literal
+bool match_pattern(const char *pattern, const char *name) {
+    const char *star = NULL;     // Last '*' seen in pattern
+    const char *resume = NULL;   // Where in name that '*' match resumes
+
+    while (*name) {
+        char ch = '\0';
+        int used = *pattern ? pattern_char(pattern, &ch) : 0;
+
+        if (*pattern == '*' && used == 0) {
+            // Try matching nothing first, remember where to back up to
+            star = pattern++;
+            resume = name;
+        } else if (*pattern == '?' && used == 0) {
+            pattern++;
+            name++;
+        } else if (used > 0 && ch == *name) {
+            pattern += used;
+            name++;
+        } else if (star) {
+            // Mismatch - let the last '*' swallow one more character
+            pattern = star + 1;
+            name = ++resume;
+        } else {
+            return false;
+        }
+    }
+
+    // Only trailing stars may be left over
+    while (*pattern == '*') {
+        pattern++;
+    }
+    return *pattern == '\0';
+}
+
+// Visit every assignment with entries at or below node
+// name holds the path to node (depth characters); pattern is NULL when
+// every assignment below node is known to match
+static void visit_subtree(TrieNode *node, char *name, int depth, const char *pattern,
+                          AssignmentFunc func, void *arg) {
+    name[depth] = '\0';
+    if (node->count > 0 && (!pattern || match_pattern(pattern, name))) {
+        func(name, node, arg);
+    }
+
+    for (TrieNode *child = node->child; child; child = child->sibling) {
+        name[depth] = child->ch;
+        visit_subtree(child, name, depth + 1, pattern, func, arg);
+    }
+}
+
+// Call func for every assignment matching pattern, in name order
+// Only the part of the trie under the pattern's literal prefix is visited
+void visit_assignments(GradeList *list, const char *pattern, AssignmentFunc func, void *arg) {
+    if (!list || !pattern || !func) {
+        return;
+    }
+
+    // Split off the literal prefix before the first wildcard
+    char name[22];
+    int prefix_len = 0;
+    const char *rest = pattern;
+    char ch;
+    int used;
+    while (*rest && (used = pattern_char(rest, &ch)) > 0) {
+        if (prefix_len == 20) {
+            return;  // Longer than any assignment name
+        }
+        name[prefix_len++] = ch;
+        rest += used;
+    }
+    name[prefix_len] = '\0';
+
+    TrieNode *node = index_find(list->index, name, false);
+    if (!node) {
+        return;
+    }
+
+    // No wildcard - exact lookup
+    if (*rest == '\0') {
+        if (node->count > 0) {
+            func(name, node, arg);
+        }
+        return;
+    }
+
+    // A single trailing '*' matches the whole subtree without checking
+    visit_subtree(node, name, prefix_len, strcmp(rest, "*") == 0 ? NULL : pattern, func, arg);
+}
@@ -11,10 +11,18 @@ GradeList* create_list(void) {
         return NULL;
     }
     
+    // Allocate the root of the assignment index (the empty name)
+    list->index = calloc(1, sizeof(TrieNode));
+    if (!list->index) {
+        free(list);
+        return NULL;
+    }
+    
     // Initialize empty list
     list->head = NULL;
     list->tail = NULL;
     list->count = 0;
+    list->next_order = 0;
     
     return list;
 }
@@ -33,7 +41,8 @@ void free_list(GradeList *list) {
         current = next;               // Move to next node
     }
     
-    // Free the list structure itself
+    // Free the assignment index and the list structure itself
+    free_index(list->index);
     free(list);
 }
 
@@ -43,15 +52,21 @@ bool add_entry(GradeList *list, const char *student_id, const char *assignment,
         return false;
     }
     
+    // Find (or create) the index entry for this assignment
+    TrieNode *slot = index_find(list->index, assignment, true);
+    if (!slot) {
+        return false;
+    }
+    
     // Check if this student already has a grade for this assignment
-    Node *current = list->head;
+    // Only entries for the same assignment need to be compared
+    Node *current = slot->first;
     while (current) {
-        // Compare both student ID and assignment name
-        if (strcmp(current->entry.studentId, student_id) == 0 && strcmp(current->entry.assignmentName, assignment) == 0) {
+        if (strcmp(current->entry.studentId, student_id) == 0) {
             // Duplicate found - cannot add
             return false;
         }
-        current = current->next;
+        current = current->next_same;
     }
     
     // Create a new node
@@ -72,6 +87,18 @@ bool add_entry(GradeList *list, const char *student_id, const char *assignment,
     
     new_node->entry.grade = grade;
     new_node->next = NULL;
+    new_node->prev = list->tail;
+    new_node->order = list->next_order++;
+    
+    // Add node to end of its assignment's entries
+    new_node->prev_same = slot->last;
+    if (slot->last) {
+        slot->last->next_same = new_node;
+    } else {
+        slot->first = new_node;
+    }
+    slot->last = new_node;
+    slot->count++;
     
     // Add node to end of list
     if (list->tail) {
@@ -90,44 +117,53 @@ bool add_entry(GradeList *list, const char *student_id, const char *assignment,
 
 // Remove a grade entry from the list
 bool remove_entry(GradeList *list, const char *student_id, const char *assignment) {
-    if (!list || !list->head) {
+    if (!list || !list->head || !student_id || !assignment) {
         return false;
     }
     
-    Node *current = list->head;
-    Node *prev = NULL;
+    // Only entries for the same assignment need to be searched
+    TrieNode *slot = index_find(list->index, assignment, false);
+    if (!slot) {
+        return false;
+    }
     
-    // Search for the entry to remove
-    while (current) {
-        // Check if this is the entry we're looking for
-        if (strcmp(current->entry.studentId, student_id) == 0 &&
-            strcmp(current->entry.assignmentName, assignment) == 0) {
-            
-            // Found it - now remove it from the list
-            if (prev) {
-                // Not the first node - link previous to next
-                prev->next = current->next;
-            } else {
-                // This is the first node - update head
-                list->head = current->next;
-            }
-            
-            // If this was the last node, update tail
-            if (current == list->tail) {
-                list->tail = prev;
-            }
-            
-            // Free the removed node
-            free(current);
-            list->count--;
-            return true;
-        }
-        
-        // Move to next node
-        prev = current;
-        current = current->next;
+    Node *current = slot->first;
+    while (current && strcmp(current->entry.studentId, student_id) != 0) {
+        current = current->next_same;
     }
     
     // Entry not found
-    return false;
-}
\ No newline at end of file
+    if (!current) {
+        return false;
+    }
+    
+    // Unlink it from the list
+    if (current->prev) {
+        current->prev->next = current->next;
+    } else {
+        list->head = current->next;
+    }
+    if (current->next) {
+        current->next->prev = current->prev;
+    } else {
+        list->tail = current->prev;
+    }
+    
+    // Unlink it from its assignment's entries
+    if (current->prev_same) {
+        current->prev_same->next_same = current->next_same;
+    } else {
+        slot->first = current->next_same;
+    }
+    if (current->next_same) {
+        current->next_same->prev_same = current->prev_same;
+    } else {
+        slot->last = current->prev_same;
+    }
+    slot->count--;
+    
+    // Free the removed node
+    free(current);
+    list->count--;
+    return true;
+}
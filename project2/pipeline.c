@@ -0,0 +1,192 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "grades.h"
+
+// Number of slots in each ring
+#define RING_CAPACITY 1024
+
+// Output size at which the executor hands a chunk to the writer
+#define OUTPUT_CHUNK 4096
+
+// State shared between the reader thread and the executor
+typedef struct {
+    SpscRing *commands;        // Parsed commands, NULL marks the end
+    int failed;                // Reader ran out of memory and stopped early
+} ReaderState;
+
+// Reader thread: read stdin and push parsed commands
+// A NULL item marks the end of input
+static void* reader_main(void *data) {
+    ReaderState *state = data;
+
+    char *line = NULL;
+    size_t len = 0;
+    ssize_t read;
+
+    while ((read = getline(&line, &len, stdin)) != -1) {
+        // Remove newline character at end of input
+        if (read > 0 && line[read - 1] == '\n') {
+            line[read - 1] = '\0';
+            read--;
+        }
+
+        // Empty lines do nothing, so the executor never needs to see them
+        Command parsed;
+        parse_workspace_command(line, &parsed);
+        if (parsed.type == CMD_NONE) {
+            continue;
+        }
+
+        // The course name of 'use' points into line, which is reused,
+        // so it is copied into the same allocation right after the command
+        size_t extra = parsed.type == CMD_USE ? strlen(parsed.courseName) + 1 : 0;
+
+        // Dropping a command could silently lose an add or remove,
+        // so running out of memory stops the whole session
+        Command *cmd = malloc(sizeof(Command) + extra);
+        if (!cmd) {
+            fprintf(stderr, "Error: Out of memory\n");
+            __atomic_store_n(&state->failed, 1, __ATOMIC_SEQ_CST);
+            break;
+        }
+
+        *cmd = parsed;
+        if (extra > 0) {
+            char *name = (char *)(cmd + 1);
+            memcpy(name, parsed.courseName, extra);
+            cmd->courseName = name;
+        }
+
+        ring_push(state->commands, cmd);
+    }
+
+    free(line);
+    ring_push(state->commands, NULL);
+    return NULL;
+}
+
+// Writer thread: pop rendered output and write it to stdout
+// A NULL item marks the end of output
+static void* writer_main(void *data) {
+    SpscRing *output = data;
+
+    char *text;
+    while ((text = ring_pop(output)) != NULL) {
+        fputs(text, stdout);
+        free(text);
+
+        // Nothing else queued - make the output visible now
+        if (ring_empty(output)) {
+            fflush(stdout);
+        }
+    }
+
+    fflush(stdout);
+    return NULL;
+}
+
+// Close the executor's memory stream and hand its output to the writer
+// buffer and size are only final once the stream is closed
+static void hand_over(SpscRing *output, FILE *mem, char **buffer, size_t *size) {
+    set_command_output(NULL);
+    fclose(mem);
+    if (*size > 0) {
+        ring_push(output, *buffer);
+    } else {
+        free(*buffer);
+    }
+}
+
+// Run commands from stdin against the workspace using three threads:
+// a reader that parses input, this thread executing commands, and a
+// writer that prints their output. Output is the same as running
+// process_workspace_command on each line in order.
+// Returns false if the threads could not be started; no input has been
+// read in that case, so the caller can fall back to the normal loop.
+// *failed is set if the session had to stop because memory ran out, in
+// which case the database must not be saved.
+bool run_pipeline(Workspace *ws, bool *failed) {
+    if (!ws || !failed) {
+        return false;
+    }
+    *failed = false;
+
+    SpscRing *commands = create_ring(RING_CAPACITY);
+    SpscRing *output = create_ring(RING_CAPACITY);
+    if (!commands || !output) {
+        free_ring(commands);
+        free_ring(output);
+        return false;
+    }
+    ReaderState state = { commands, 0 };
+
+    // Start the writer first so a failed reader leaves no input consumed
+    pthread_t writer;
+    pthread_t reader;
+    if (pthread_create(&writer, NULL, writer_main, output) != 0) {
+        free_ring(commands);
+        free_ring(output);
+        return false;
+    }
+
+    if (pthread_create(&reader, NULL, reader_main, &state) != 0) {
+        ring_push(output, NULL);
+        pthread_join(writer, NULL);
+        free_ring(commands);
+        free_ring(output);
+        return false;
+    }
+
+    // Execute commands, collecting their output in memory
+    char *buffer = NULL;
+    size_t size = 0;
+    FILE *mem = NULL;
+    Command *cmd;
+    while ((cmd = ring_pop(commands)) != NULL) {
+        // After a failure keep draining so the reader can finish
+        if (*failed) {
+            free(cmd);
+            continue;
+        }
+
+        if (!mem) {
+            mem = open_memstream(&buffer, &size);
+            if (!mem) {
+                // Skipping the command could lose an add or remove
+                fprintf(stderr, "Error: Out of memory\n");
+                *failed = true;
+                free(cmd);
+                continue;
+            }
+            set_command_output(mem);
+        }
+
+        execute_workspace_command(cmd, ws);
+        free(cmd);
+
+        // Hand the output over once a chunk has built up, or straight
+        // away if no more input is waiting (interactive use)
+        if (ftell(mem) >= OUTPUT_CHUNK || ring_empty(commands)) {
+            hand_over(output, mem, &buffer, &size);
+            mem = NULL;
+        }
+    }
+
+    // Hand over anything left and stop the writer
+    if (mem) {
+        hand_over(output, mem, &buffer, &size);
+    }
+    ring_push(output, NULL);
+
+    // Clean up
+    pthread_join(reader, NULL);
+    pthread_join(writer, NULL);
+    if (__atomic_load_n(&state.failed, __ATOMIC_SEQ_CST)) {
+        *failed = true;
+    }
+    free_ring(commands);
+    free_ring(output);
+    return true;
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "grades.h"
+
+// Worker loop: take task indices from the current batch until shutdown
+static void* worker_main(void *data) {
+    ThreadPool *pool = data;
+
+    pthread_mutex_lock(&pool->lock);
+    while (true) {
+        // Sleep until there is a task to take or the pool is closing
+        while (!pool->shutdown && pool->next_task >= pool->task_count) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+
+        if (pool->shutdown) {
+            break;
+        }
+
+        // Claim the next task and run it without holding the lock
+        int index = pool->next_task++;
+        TaskFunc func = pool->func;
+        void *arg = pool->arg;
+        pthread_mutex_unlock(&pool->lock);
+
+        func(arg, index);
+
+        pthread_mutex_lock(&pool->lock);
+        pool->pending--;
+        if (pool->pending == 0) {
+            // Last task of the batch - wake up pool_run
+            pthread_cond_signal(&pool->work_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+// Create a pool with the given number of worker threads
+ThreadPool* create_pool(int thread_count) {
+    if (thread_count < 1) {
+        return NULL;
+    }
+
+    ThreadPool *pool = malloc(sizeof(ThreadPool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->threads = malloc(thread_count * sizeof(pthread_t));
+    if (!pool->threads) {
+        free(pool);
+        return NULL;
+    }
+
+    // Initialize an idle pool with no batch posted
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    pool->func = NULL;
+    pool->arg = NULL;
+    pool->next_task = 0;
+    pool->task_count = 0;
+    pool->pending = 0;
+    pool->shutdown = false;
+    pool->thread_count = 0;
+
+    // Start the workers
+    for (int i = 0; i < thread_count; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_main, pool) != 0) {
+            break;
+        }
+        pool->thread_count++;
+    }
+
+    // Could not start any worker at all
+    if (pool->thread_count == 0) {
+        free_pool(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+// Run func(arg, i) for every i in [0, task_count) and wait for all of them
+// Falls back to running the tasks on the calling thread if pool is NULL
+void pool_run(ThreadPool *pool, int task_count, TaskFunc func, void *arg) {
+    if (!func || task_count <= 0) {
+        return;
+    }
+
+    if (!pool) {
+        for (int i = 0; i < task_count; i++) {
+            func(arg, i);
+        }
+        return;
+    }
+
+    // Post the batch and wake every worker
+    pthread_mutex_lock(&pool->lock);
+    pool->func = func;
+    pool->arg = arg;
+    pool->next_task = 0;
+    pool->task_count = task_count;
+    pool->pending = task_count;
+    pthread_cond_broadcast(&pool->work_ready);
+
+    // Wait for the last task to finish
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+
+    // Reset so idle workers go back to sleep
+    pool->next_task = 0;
+    pool->task_count = 0;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// Stop all workers and free the pool
+void free_pool(ThreadPool *pool) {
+    if (!pool) {
+        return;
+    }
+
+    // Tell workers to exit and wait for them
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->thread_count; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    // Clean up
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
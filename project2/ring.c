@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sched.h>
+#include <pthread.h>
+#include "grades.h"
+
+// Times to retry an empty or full ring before going to sleep
+#define SPIN_LIMIT 64
+
+// Create a ring holding at least capacity items
+// Only one thread may push and only one other thread may pop
+SpscRing* create_ring(size_t capacity) {
+    // Round the capacity up to a power of two so indices wrap with a mask
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    SpscRing *ring = malloc(sizeof(SpscRing));
+    if (!ring) {
+        return NULL;
+    }
+
+    ring->slots = malloc(size * sizeof(void *));
+    if (!ring->slots) {
+        free(ring);
+        return NULL;
+    }
+
+    ring->mask = size - 1;
+    ring->head = 0;
+    ring->tail = 0;
+    pthread_mutex_init(&ring->lock, NULL);
+    pthread_cond_init(&ring->not_empty, NULL);
+    pthread_cond_init(&ring->not_full, NULL);
+    ring->consumer_waiting = 0;
+    ring->producer_waiting = 0;
+    return ring;
+}
+
+// Free the ring (items still inside are not freed)
+void free_ring(SpscRing *ring) {
+    if (!ring) {
+        return;
+    }
+
+    pthread_cond_destroy(&ring->not_full);
+    pthread_cond_destroy(&ring->not_empty);
+    pthread_mutex_destroy(&ring->lock);
+    free(ring->slots);
+    free(ring);
+}
+
+// Check whether the ring has no free slot (producer side)
+static bool ring_full(SpscRing *ring, size_t tail) {
+    return tail - __atomic_load_n(&ring->head, __ATOMIC_SEQ_CST) > ring->mask;
+}
+
+// Wake the other side if it announced it is going to sleep
+// The sequentially consistent load pairs with the sleeper's store of its
+// flag, so either the sleeper sees the new index or we see the flag
+static void wake(SpscRing *ring, int *waiting, pthread_cond_t *cond) {
+    if (__atomic_load_n(waiting, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&ring->lock);
+        pthread_cond_signal(cond);
+        pthread_mutex_unlock(&ring->lock);
+    }
+}
+
+// Add an item, waiting while the ring is full (producer only)
+void ring_push(SpscRing *ring, void *item) {
+    size_t tail = ring->tail;
+
+    // Spin briefly for the consumer to free a slot
+    for (int spins = 0; ring_full(ring, tail) && spins < SPIN_LIMIT; spins++) {
+        sched_yield();
+    }
+
+    // Still full - sleep until the consumer pops something
+    if (ring_full(ring, tail)) {
+        pthread_mutex_lock(&ring->lock);
+        __atomic_store_n(&ring->producer_waiting, 1, __ATOMIC_SEQ_CST);
+        while (ring_full(ring, tail)) {
+            pthread_cond_wait(&ring->not_full, &ring->lock);
+        }
+        __atomic_store_n(&ring->producer_waiting, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&ring->lock);
+    }
+
+    // Store the item, then publish it by moving the tail
+    ring->slots[tail & ring->mask] = item;
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_SEQ_CST);
+
+    wake(ring, &ring->consumer_waiting, &ring->not_empty);
+}
+
+// Remove the oldest item, waiting while the ring is empty (consumer only)
+void* ring_pop(SpscRing *ring) {
+    size_t head = ring->head;
+
+    // Spin briefly for the producer to publish an item
+    for (int spins = 0; ring_empty(ring) && spins < SPIN_LIMIT; spins++) {
+        sched_yield();
+    }
+
+    // Still empty - sleep until the producer pushes something
+    if (ring_empty(ring)) {
+        pthread_mutex_lock(&ring->lock);
+        __atomic_store_n(&ring->consumer_waiting, 1, __ATOMIC_SEQ_CST);
+        while (ring_empty(ring)) {
+            pthread_cond_wait(&ring->not_empty, &ring->lock);
+        }
+        __atomic_store_n(&ring->consumer_waiting, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&ring->lock);
+    }
+
+    // Read the item, then hand the slot back by moving the head
+    void *item = ring->slots[head & ring->mask];
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_SEQ_CST);
+
+    wake(ring, &ring->producer_waiting, &ring->not_full);
+    return item;
+}
+
+// Check whether the ring has nothing to pop (consumer only)
+bool ring_empty(SpscRing *ring) {
+    return __atomic_load_n(&ring->tail, __ATOMIC_SEQ_CST) == ring->head;
+}
@@ -0,0 +1,552 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include "grades.h"
+
+// Most runs merged in one pass; more runs take several passes
+#define MAX_MERGE_WAYS 64
+
+// Smallest read buffer worth giving to each run during a merge
+#define MIN_MERGE_BUFFER (16 * 1024)
+
+// Entry tagged with its line number, the record sorted to find duplicates
+typedef struct {
+    struct GradeEntry entry;   // The grade entry data
+    long line;                 // Line number in the database file
+} LineEntry;
+
+// Buffered reader over one sorted run inside a spill file
+typedef struct {
+    char *buffer;              // Records read from the run
+    size_t size;               // Bytes of buffer in use
+    size_t offset;             // Position of the next record in buffer
+    off_t pos;                 // Next byte of the run to read from the file
+    off_t end;                 // End of the run in the file
+} RunReader;
+
+// Called for every valid entry while streaming the database file
+typedef void (*EntryFunc)(const struct GradeEntry *entry, long line, bool duplicate, void *arg);
+
+// Order line entries by student ID, then assignment, then line number
+static int compare_line_entries(const void *a, const void *b) {
+    const LineEntry *x = a;
+    const LineEntry *y = b;
+
+    int result = strcmp(x->entry.studentId, y->entry.studentId);
+    if (result == 0) {
+        result = strcmp(x->entry.assignmentName, y->entry.assignmentName);
+    }
+    if (result == 0) {
+        result = (x->line > y->line) - (x->line < y->line);
+    }
+    return result;
+}
+
+// Order line numbers ascending
+static int compare_lines(const void *a, const void *b) {
+    long x = *(const long *)a;
+    long y = *(const long *)b;
+    return (x > y) - (x < y);
+}
+
+// Fill the reader's buffer with the next part of its run
+// Returns false on a read error
+static bool run_refill(RunReader *run, int fd, size_t capacity) {
+    size_t want = capacity;
+    if ((off_t)want > run->end - run->pos) {
+        want = run->end - run->pos;
+    }
+
+    size_t got = 0;
+    while (got < want) {
+        ssize_t n = pread(fd, run->buffer + got, want - got, run->pos + got);
+        if (n <= 0) {
+            return false;
+        }
+        got += n;
+    }
+
+    run->pos += got;
+    run->size = got;
+    run->offset = 0;
+    return true;
+}
+
+// Merge runs [first, first + count) of the spill file into out
+// Run i covers bytes bounds[i] to bounds[i + 1]; buffers holds count
+// read buffers of buffer_size bytes
+static bool merge_runs(int fd, const off_t *bounds, int first, int count, FILE *out,
+                       size_t rec_size, int (*cmp)(const void *, const void *),
+                       char *buffers, size_t buffer_size) {
+    RunReader *runs = calloc(count, sizeof(RunReader));
+    if (!runs) {
+        return false;
+    }
+
+    // Prime every reader with the start of its run
+    bool ok = true;
+    for (int i = 0; i < count && ok; i++) {
+        runs[i].buffer = buffers + i * buffer_size;
+        runs[i].pos = bounds[first + i];
+        runs[i].end = bounds[first + i + 1];
+        ok = run_refill(&runs[i], fd, buffer_size);
+    }
+
+    while (ok) {
+        // Find the run whose next record is smallest
+        int best = -1;
+        for (int i = 0; i < count; i++) {
+            if (runs[i].offset == runs[i].size) {
+                continue;  // Run exhausted
+            }
+            if (best == -1 || cmp(runs[i].buffer + runs[i].offset,
+                                  runs[best].buffer + runs[best].offset) < 0) {
+                best = i;
+            }
+        }
+
+        // All runs exhausted
+        if (best == -1) {
+            break;
+        }
+
+        if (fwrite(runs[best].buffer + runs[best].offset, rec_size, 1, out) != 1) {
+            ok = false;
+            break;
+        }
+
+        // Move past the record, reading more of the run if needed
+        runs[best].offset += rec_size;
+        if (runs[best].offset == runs[best].size && runs[best].pos < runs[best].end) {
+            ok = run_refill(&runs[best], fd, buffer_size);
+        }
+    }
+
+    free(runs);
+    return ok;
+}
+
+// Sort fixed-size records from in into out using at most mem_limit bytes
+// Sorted runs that do not fit in memory are spilled to temporary files
+// and merged, taking several passes if there are too many runs
+static bool external_sort(FILE *in, FILE *out, size_t rec_size,
+                          int (*cmp)(const void *, const void *), size_t mem_limit) {
+    // qsort may allocate scratch space as large as the array it sorts,
+    // and the allocator can keep scratch from an earlier sort, so the
+    // chunk only gets a third of the memory. It is reused for merging.
+    size_t chunk_size = mem_limit / 3;
+    size_t chunk_records = chunk_size / rec_size;
+    char *chunk = malloc(chunk_records * rec_size);
+    if (!chunk) {
+        return false;
+    }
+
+    FILE *spill = tmpfile();
+    int runs = 0;
+    int capacity = 16;
+    off_t *bounds = malloc((capacity + 1) * sizeof(off_t));
+    if (!spill || !bounds) {
+        if (spill) fclose(spill);
+        free(bounds);
+        free(chunk);
+        return false;
+    }
+    bounds[0] = 0;
+
+    // Phase 1: write memory-sized sorted runs to the spill file
+    bool ok = true;
+    size_t n;
+    while (ok && (n = fread(chunk, rec_size, chunk_records, in)) > 0) {
+        qsort(chunk, n, rec_size, cmp);
+
+        // Everything fit in one chunk - no spilling needed
+        if (runs == 0 && n < chunk_records && !ferror(in)) {
+            ok = fwrite(chunk, rec_size, n, out) == n;
+            free(chunk);
+            free(bounds);
+            fclose(spill);
+            return ok;
+        }
+
+        // Grow the run table if needed
+        if (runs == capacity) {
+            capacity *= 2;
+            off_t *grown = realloc(bounds, (capacity + 1) * sizeof(off_t));
+            if (!grown) {
+                ok = false;
+                break;
+            }
+            bounds = grown;
+        }
+
+        ok = fwrite(chunk, rec_size, n, spill) == n;
+        runs++;
+        bounds[runs] = bounds[runs - 1] + (off_t)(n * rec_size);
+    }
+
+    if (ferror(in) || fflush(spill) != 0) {
+        ok = false;
+    }
+
+    // Split the chunk between merge buffers, one per run
+    int ways = chunk_size / MIN_MERGE_BUFFER;
+    if (ways < 2) ways = 2;
+    if (ways > MAX_MERGE_WAYS) ways = MAX_MERGE_WAYS;
+    size_t buffer_size = (chunk_size / ways) / rec_size * rec_size;
+
+    // Phase 2: merge groups of runs until one pass can finish the job
+    while (ok && runs > ways) {
+        FILE *next = tmpfile();
+        off_t *next_bounds = malloc((runs / ways + 2) * sizeof(off_t));
+        if (!next || !next_bounds) {
+            if (next) fclose(next);
+            free(next_bounds);
+            ok = false;
+            break;
+        }
+
+        int next_runs = 0;
+        next_bounds[0] = 0;
+        for (int first = 0; ok && first < runs; first += ways) {
+            int count = (runs - first < ways) ? runs - first : ways;
+            ok = merge_runs(fileno(spill), bounds, first, count, next,
+                            rec_size, cmp, chunk, buffer_size);
+            next_runs++;
+            next_bounds[next_runs] = next_bounds[next_runs - 1] +
+                                     (bounds[first + count] - bounds[first]);
+        }
+        if (fflush(next) != 0) {
+            ok = false;
+        }
+
+        // The merged file replaces the old spill file
+        fclose(spill);
+        free(bounds);
+        spill = next;
+        bounds = next_bounds;
+        runs = next_runs;
+    }
+
+    // Phase 3: final merge straight into the output
+    if (ok && runs > 0) {
+        ok = merge_runs(fileno(spill), bounds, 0, runs, out, rec_size, cmp, chunk, buffer_size);
+    }
+
+    fclose(spill);
+    free(bounds);
+    free(chunk);
+    return ok;
+}
+
+// Find every entry that repeats an earlier (student ID, assignment) pair
+// load_database keeps the first occurrence, so later ones are duplicates.
+// Their line numbers are stored sorted in db->duplicates.
+static bool build_duplicate_index(StreamDb *db) {
+    FILE *file = fopen(db->filename, "r");
+    if (!file) {
+        return false;
+    }
+
+    FILE *entries = tmpfile();
+    FILE *sorted = tmpfile();
+    FILE *dup_lines = tmpfile();
+    FILE *duplicates = tmpfile();
+    bool ok = entries && sorted && dup_lines && duplicates;
+
+    // Write every valid entry with its line number
+    char *line = NULL;
+    size_t len = 0;
+    ssize_t read;
+    long line_no = 0;
+    while (ok && (read = getline(&line, &len, file)) != -1) {
+        line_no++;
+
+        LineEntry record;
+        if (!parse_entry_line(line, read, &record.entry)) {
+            continue;
+        }
+        record.line = line_no;
+        ok = fwrite(&record, sizeof(record), 1, entries) == 1;
+    }
+    free(line);
+    fclose(file);
+
+    // Group equal entries together, earliest line first
+    if (ok) {
+        rewind(entries);
+        ok = external_sort(entries, sorted, sizeof(LineEntry), compare_line_entries, db->mem_limit);
+    }
+
+    // Every entry after the first of its group is a duplicate
+    long count = 0;
+    if (ok) {
+        rewind(sorted);
+        LineEntry prev;
+        LineEntry current;
+        bool have_prev = false;
+        while (ok && fread(&current, sizeof(current), 1, sorted) == 1) {
+            if (have_prev &&
+                strcmp(prev.entry.studentId, current.entry.studentId) == 0 &&
+                strcmp(prev.entry.assignmentName, current.entry.assignmentName) == 0) {
+                ok = fwrite(&current.line, sizeof(long), 1, dup_lines) == 1;
+                count++;
+            } else {
+                prev = current;
+                have_prev = true;
+            }
+        }
+        ok = ok && !ferror(sorted);
+    }
+
+    // Put duplicate line numbers back into file order
+    if (ok) {
+        rewind(dup_lines);
+        ok = external_sort(dup_lines, duplicates, sizeof(long), compare_lines, db->mem_limit);
+    }
+
+    // Clean up
+    if (entries) fclose(entries);
+    if (sorted) fclose(sorted);
+    if (dup_lines) fclose(dup_lines);
+
+    if (!ok) {
+        if (duplicates) fclose(duplicates);
+        return false;
+    }
+
+    db->duplicates = duplicates;
+    db->duplicate_count = count;
+    return true;
+}
+
+// Call func for every valid entry of the database file, in file order
+static bool scan_database(StreamDb *db, EntryFunc func, void *arg) {
+    FILE *file = fopen(db->filename, "r");
+    if (!file) {
+        return false;
+    }
+
+    // Read duplicate line numbers alongside the file
+    rewind(db->duplicates);
+    long next_dup = 0;
+    bool have_dup = fread(&next_dup, sizeof(long), 1, db->duplicates) == 1;
+
+    char *line = NULL;
+    size_t len = 0;
+    ssize_t read;
+    long line_no = 0;
+    while ((read = getline(&line, &len, file)) != -1) {
+        line_no++;
+
+        struct GradeEntry entry;
+        if (!parse_entry_line(line, read, &entry)) {
+            continue;
+        }
+
+        // Skip past duplicate line numbers before this line
+        while (have_dup && next_dup < line_no) {
+            have_dup = fread(&next_dup, sizeof(long), 1, db->duplicates) == 1;
+        }
+
+        func(&entry, line_no, have_dup && next_dup == line_no, arg);
+    }
+
+    free(line);
+    fclose(file);
+    return true;
+}
+
+// Create a streaming view of a database file
+StreamDb* create_stream_db(const char *filename, size_t mem_limit) {
+    if (!filename || mem_limit < MIN_MEM_LIMIT) {
+        return NULL;
+    }
+
+    StreamDb *db = malloc(sizeof(StreamDb));
+    if (!db) {
+        return NULL;
+    }
+
+    db->filename = malloc(strlen(filename) + 1);
+    if (!db->filename) {
+        free(db);
+        return NULL;
+    }
+    strcpy(db->filename, filename);
+
+    // The duplicate index is built by the first command
+    db->mem_limit = mem_limit;
+    db->duplicates = NULL;
+    db->duplicate_count = 0;
+    return db;
+}
+
+// Free the streaming view and its spill file
+void free_stream_db(StreamDb *db) {
+    if (!db) {
+        return;
+    }
+
+    if (db->duplicates) {
+        fclose(db->duplicates);
+    }
+    free(db->filename);
+    free(db);
+}
+
+// State for streaming print
+typedef struct {
+    const char *assignment;    // Assignment name or pattern, NULL for all
+} PrintScan;
+
+// Print one entry if it passes the filter
+static void print_entry(const struct GradeEntry *entry, long line, bool duplicate, void *arg) {
+    PrintScan *scan = arg;
+    (void)line;
+
+    if (duplicate) {
+        return;
+    }
+    if (!scan->assignment || match_pattern(scan->assignment, entry->assignmentName)) {
+        print_table_row(entry);
+    }
+}
+
+// State for streaming stats
+typedef struct {
+    const char *assignment;    // Assignment name or pattern to summarize
+    struct GradeStats stats;   // Running statistics
+} StatsScan;
+
+// Add one entry to the running statistics if it matches
+static void stats_entry(const struct GradeEntry *entry, long line, bool duplicate, void *arg) {
+    StatsScan *scan = arg;
+    (void)line;
+
+    if (duplicate || !match_pattern(scan->assignment, entry->assignmentName)) {
+        return;
+    }
+
+    struct GradeStats one = { 1L, (long long)entry->grade, entry->grade, entry->grade };
+    merge_stats(&scan->stats, &one);
+}
+
+// State for streaming student lookup
+typedef struct {
+    const char *student_id;    // Student to list
+    int count;                 // Rows printed so far
+} StudentScan;
+
+// Print one entry if it belongs to the student
+static void student_entry(const struct GradeEntry *entry, long line, bool duplicate, void *arg) {
+    StudentScan *scan = arg;
+    (void)line;
+
+    if (duplicate || strcmp(entry->studentId, scan->student_id) != 0) {
+        return;
+    }
+
+    print_student_row(entry, scan->count);
+    scan->count++;
+}
+
+// Report one entry if it is a duplicate
+static void validate_entry(const struct GradeEntry *entry, long line, bool duplicate, void *arg) {
+    (void)arg;
+
+    if (duplicate) {
+        printf("Duplicate entry on line %ld: %s:%s:%hu\n",
+               line, entry->studentId, entry->assignmentName, entry->grade);
+    }
+}
+
+// Streaming command processor - runs read-only commands over the file
+void process_stream_command(char *line, StreamDb *db) {
+    if (!line || !db) {
+        return;
+    }
+
+    // Skip leading whitespace
+    while (*line == ' ' || *line == '\t') {
+        line++;
+    }
+
+    // Check for empty line
+    if (*line == '\0') {
+        return;
+    }
+
+    // Commands that change the database need the in-memory list
+    if (strncmp(line, "add ", 4) == 0 || strncmp(line, "remove ", 7) == 0) {
+        printf("Error: Command not supported in streaming mode\n");
+        return;
+    }
+
+    bool known = strncmp(line, "print", 5) == 0 ||
+                 strncmp(line, "student ", 8) == 0 ||
+                 strncmp(line, "stats ", 6) == 0 ||
+                 strcmp(line, "validate") == 0;
+    if (!known) {
+        printf("Error: Unknown command\n");
+        return;
+    }
+
+    // Every command needs to know which entries are duplicates
+    if (!db->duplicates && !build_duplicate_index(db)) {
+        printf("Error: Failed to read database\n");
+        return;
+    }
+
+    bool ok = true;
+    if (strncmp(line, "print", 5) == 0) {
+        // Print command - optional assignment name after "print "
+        PrintScan scan = { print_filter(line) };
+        if (scan.assignment && !is_valid_assignment_pattern(scan.assignment)) {
+            printf("Error: Invalid argument\n");
+            return;
+        }
+        print_table_header();
+        ok = scan_database(db, print_entry, &scan);
+    }
+    else if (strncmp(line, "student ", 8) == 0) {
+        // Student command - parse student ID after "student "
+        StudentScan scan = { line + 8, 0 };
+        if (!is_valid_student_id(scan.student_id)) {
+            printf("Error: Invalid argument\n");
+            return;
+        }
+        ok = scan_database(db, student_entry, &scan);
+        if (ok && scan.count == 0) {
+            printf("Error: No grades found for student '%s'\n", scan.student_id);
+        }
+    }
+    else if (strncmp(line, "stats ", 6) == 0) {
+        // Stats command - parse assignment name after "stats "
+        StatsScan scan = { line + 6, { 0L, 0LL, 101, -1 } };
+        if (!is_valid_assignment_pattern(scan.assignment)) {
+            printf("Error: Invalid argument\n");
+            return;
+        }
+        ok = scan_database(db, stats_entry, &scan);
+        if (ok && scan.stats.count == 0) {
+            printf("Error: No grades found for assignment '%s'\n", scan.assignment);
+        } else if (ok) {
+            print_stats(scan.assignment, &scan.stats);
+        }
+    }
+    else {
+        // Validate command - list entries that load_database would drop
+        ok = scan_database(db, validate_entry, NULL);
+        if (ok && db->duplicate_count == 0) {
+            printf("No duplicate entries found\n");
+        } else if (ok) {
+            printf("Found %ld duplicate entries\n", db->duplicate_count);
+        }
+    }
+
+    if (!ok) {
+        printf("Error: Failed to read database\n");
+    }
+}
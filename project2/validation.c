@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
 #include "grades.h"
 
 // Check if a string is a valid 10-digit student ID
@@ -36,6 +37,27 @@ bool is_valid_assignment_name(const char *name) {
     return true;
 }
 
+// Check if a string is a valid assignment pattern
+// Escapes like '\*' make a pattern longer than the names it matches, so
+// the limit of 20 applies to the characters it stands for, with up to 40
+// characters written
+bool is_valid_assignment_pattern(const char *pattern) {
+    if (!pattern) return false;
+    
+    size_t len = strlen(pattern);
+    
+    // Must be between 1 and 40 characters
+    if (len < 1 || len > 40) return false;
+    
+    // Cannot contain a colon
+    if (strchr(pattern, ':') != NULL) return false;
+    
+    // Cannot stand for a name longer than 20 characters
+    if (pattern_length(pattern) > 20) return false;
+    
+    return true;
+}
+
 // Check if a string is a valid grade (0-100) and convert it
 bool is_valid_grade(const char *grade_str, unsigned short *grade) {
     if (!grade_str || !grade) return false;
@@ -59,4 +81,47 @@ bool is_valid_grade(const char *grade_str, unsigned short *grade) {
     // Store the value
     *grade = (unsigned short)value;
     return true;
+}
+
+// Check if a string is a valid memory cap (digits with optional K, M or G
+// suffix, at least MIN_MEM_LIMIT bytes) and convert it to bytes
+bool is_valid_mem_limit(const char *limit_str, size_t *limit) {
+    if (!limit_str || !limit) return false;
+    
+    // Read the number part
+    size_t value = 0;
+    const char *p = limit_str;
+    if (!isdigit((unsigned char)*p)) return false;
+    
+    while (isdigit((unsigned char)*p)) {
+        size_t digit = *p - '0';
+        if (value > (SIZE_MAX - digit) / 10) return false;  // Overflow
+        value = value * 10 + digit;
+        p++;
+    }
+    
+    // Apply the optional unit suffix
+    size_t unit = 1;
+    if (*p == 'K' || *p == 'k') {
+        unit = 1024;
+        p++;
+    } else if (*p == 'M' || *p == 'm') {
+        unit = 1024 * 1024;
+        p++;
+    } else if (*p == 'G' || *p == 'g') {
+        unit = 1024 * 1024 * 1024;
+        p++;
+    }
+    
+    // Nothing may follow the suffix
+    if (*p != '\0') return false;
+    
+    if (value > SIZE_MAX / unit) return false;
+    value *= unit;
+    
+    // Too small to hold a useful sort buffer
+    if (value < MIN_MEM_LIMIT) return false;
+    
+    *limit = value;
+    return true;
 }
\ No newline at end of file
@@ -0,0 +1,411 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "grades.h"
+
+// Per-course result slot for a cross-course query
+typedef struct {
+    Course *course;            // Course this task works on
+    const char *key;           // Student ID or assignment name to look up
+    bool load_failed;          // Course database could not be loaded
+    struct GradeStats stats;   // Result of a stats query
+    struct GradeEntry *matches;// Result of a student query, in list order
+    int match_count;           // Entries in matches
+    int match_capacity;        // Entries matches has room for
+    bool out_of_memory;        // Some matches could not be stored
+} CourseTask;
+
+// Duplicate a string into newly allocated memory
+static char* copy_string(const char *str, size_t len) {
+    char *copy = malloc(len + 1);
+    if (!copy) {
+        return NULL;
+    }
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+// Derive the course name from a file path: strip directories and extension
+static char* course_name_from_path(const char *filename) {
+    const char *start = strrchr(filename, '/');
+    start = start ? start + 1 : filename;
+
+    // Only strip an extension if something is left in front of it
+    const char *dot = strrchr(start, '.');
+    size_t len = (dot && dot != start) ? (size_t)(dot - start) : strlen(start);
+
+    return copy_string(start, len);
+}
+
+// Create a workspace over the given database files
+// Nothing is loaded here; each course is read on first use
+Workspace* create_workspace(char **filenames, int count) {
+    if (!filenames || count < 1) {
+        return NULL;
+    }
+
+    Workspace *ws = malloc(sizeof(Workspace));
+    if (!ws) {
+        return NULL;
+    }
+
+    ws->courses = calloc(count, sizeof(Course));
+    if (!ws->courses) {
+        free(ws);
+        return NULL;
+    }
+    ws->count = count;
+    ws->current = 0;
+    ws->pool = NULL;
+
+    for (int i = 0; i < count; i++) {
+        ws->courses[i].filename = copy_string(filenames[i], strlen(filenames[i]));
+        ws->courses[i].name = course_name_from_path(filenames[i]);
+        if (!ws->courses[i].filename || !ws->courses[i].name) {
+            free_workspace(ws);
+            return NULL;
+        }
+
+        // Course names are used by 'use', so they must be unique
+        for (int j = 0; j < i; j++) {
+            if (strcmp(ws->courses[j].name, ws->courses[i].name) == 0) {
+                fprintf(stderr, "Error: Duplicate course name '%s'\n", ws->courses[i].name);
+                free_workspace(ws);
+                return NULL;
+            }
+        }
+    }
+
+    // Cross-course queries only need workers when there is more than one course
+    if (count > 1) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        int threads = (cpus > 0 && cpus < count) ? (int)cpus : count;
+        ws->pool = create_pool(threads);  // NULL means queries run sequentially
+    }
+
+    return ws;
+}
+
+// Free the workspace and every loaded course
+void free_workspace(Workspace *ws) {
+    if (!ws) {
+        return;
+    }
+
+    free_pool(ws->pool);
+
+    for (int i = 0; i < ws->count; i++) {
+        free_list(ws->courses[i].list);
+        free(ws->courses[i].name);
+        free(ws->courses[i].filename);
+    }
+
+    free(ws->courses);
+    free(ws);
+}
+
+// Get the entries of a course, loading its database on first use
+// Returns NULL if the database cannot be loaded
+GradeList* course_list(Course *course) {
+    if (!course) {
+        return NULL;
+    }
+
+    if (course->list) {
+        return course->list;
+    }
+
+    GradeList *list = create_list();
+    if (!list) {
+        return NULL;
+    }
+
+    if (!load_database(course->filename, list)) {
+        free_list(list);
+        return NULL;
+    }
+
+    course->list = list;
+    return list;
+}
+
+// Save every course that was loaded during the session
+bool save_workspace(Workspace *ws) {
+    if (!ws) {
+        return false;
+    }
+
+    bool ok = true;
+    for (int i = 0; i < ws->count; i++) {
+        // Courses never loaded cannot have changed
+        if (!ws->courses[i].list) {
+            continue;
+        }
+
+        if (!save_database(ws->courses[i].filename, ws->courses[i].list)) {
+            fprintf(stderr, "Error: Failed to save course '%s'\n", ws->courses[i].name);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+// Task: compute statistics for one course
+static void stats_task(void *arg, int index) {
+    CourseTask *task = &((CourseTask *)arg)[index];
+
+    GradeList *list = course_list(task->course);
+    if (!list) {
+        task->load_failed = true;
+        return;
+    }
+
+    compute_stats(list, task->key, &task->stats);
+}
+
+// Task: collect one student's grades from one course
+static void student_task(void *arg, int index) {
+    CourseTask *task = &((CourseTask *)arg)[index];
+
+    GradeList *list = course_list(task->course);
+    if (!list) {
+        task->load_failed = true;
+        return;
+    }
+
+    Node *current = list->head;
+    while (current) {
+        if (strcmp(current->entry.studentId, task->key) == 0) {
+            // Grow the result array as needed
+            if (task->match_count == task->match_capacity) {
+                int capacity = task->match_capacity ? task->match_capacity * 2 : 16;
+                struct GradeEntry *grown = realloc(task->matches, capacity * sizeof(struct GradeEntry));
+                if (!grown) {
+                    task->out_of_memory = true;
+                    return;
+                }
+                task->matches = grown;
+                task->match_capacity = capacity;
+            }
+            task->matches[task->match_count++] = current->entry;
+        }
+        current = current->next;
+    }
+}
+
+// Run a task over every course in parallel
+// Returns the task array, which the caller must free
+static CourseTask* run_course_tasks(Workspace *ws, const char *key, TaskFunc func) {
+    CourseTask *tasks = calloc(ws->count, sizeof(CourseTask));
+    if (!tasks) {
+        return NULL;
+    }
+
+    for (int i = 0; i < ws->count; i++) {
+        tasks[i].course = &ws->courses[i];
+        tasks[i].key = key;
+    }
+
+    pool_run(ws->pool, ws->count, func, tasks);
+
+    // Report courses that could not be read, in course order
+    for (int i = 0; i < ws->count; i++) {
+        if (tasks[i].load_failed) {
+            fprintf(command_stream(), "Error: Failed to load course '%s'\n", tasks[i].course->name);
+        }
+    }
+
+    return tasks;
+}
+
+// Print statistics for an assignment merged across all courses
+static void cmd_stats_all(Workspace *ws, const char *assignment) {
+    CourseTask *tasks = run_course_tasks(ws, assignment, stats_task);
+    if (!tasks) {
+        fprintf(command_stream(), "Error: Out of memory\n");
+        return;
+    }
+
+    // Merge the per-course results
+    struct GradeStats total = { 0L, 0LL, 101, -1 };
+    for (int i = 0; i < ws->count; i++) {
+        merge_stats(&total, &tasks[i].stats);
+    }
+    free(tasks);
+
+    if (total.count == 0) {
+        fprintf(command_stream(), "Error: No grades found for assignment '%s'\n", assignment);
+        return;
+    }
+
+    char label[64];
+    snprintf(label, sizeof(label), "%s (all courses)", assignment);
+    print_stats(label, &total);
+}
+
+// Print a student's grades from every course
+static void cmd_student_all(Workspace *ws, const char *student_id) {
+    CourseTask *tasks = run_course_tasks(ws, student_id, student_task);
+    if (!tasks) {
+        fprintf(command_stream(), "Error: Out of memory\n");
+        return;
+    }
+
+    // Merge the per-course results in course order
+    int count = 0;
+    bool out_of_memory = false;
+    for (int i = 0; i < ws->count; i++) {
+        for (int j = 0; j < tasks[i].match_count; j++) {
+            // Print header before the first match only
+            if (count == 0) {
+                fprintf(command_stream(), "%-20s | %-20s | %5s\n", "Course", "Assignment Name", "Grade");
+                fprintf(command_stream(), "---------------------------------------------------\n");
+            }
+            fprintf(command_stream(), "%-20s | %-20s | %5hu\n", tasks[i].course->name,
+                   tasks[i].matches[j].assignmentName, tasks[i].matches[j].grade);
+            count++;
+        }
+        out_of_memory = out_of_memory || tasks[i].out_of_memory;
+        free(tasks[i].matches);
+    }
+    free(tasks);
+
+    if (out_of_memory) {
+        fprintf(command_stream(), "Error: Out of memory\n");
+        return;
+    }
+
+    if (count == 0) {
+        fprintf(command_stream(), "Error: No grades found for student '%s'\n", student_id);
+    }
+}
+
+// List the courses in the workspace, marking the current one
+static void cmd_courses(Workspace *ws) {
+    for (int i = 0; i < ws->count; i++) {
+        fprintf(command_stream(), "%c %s\n", i == ws->current ? '*' : ' ', ws->courses[i].name);
+    }
+}
+
+// Switch the current course
+static void cmd_use(Workspace *ws, const char *name) {
+    for (int i = 0; i < ws->count; i++) {
+        if (strcmp(ws->courses[i].name, name) == 0) {
+            ws->current = i;
+            return;
+        }
+    }
+
+    fprintf(command_stream(), "Error: Unknown course '%s'\n", name);
+}
+
+// Parse one input line, including workspace commands, without executing it
+// Never prints; anything that is not a workspace command is handed to
+// parse_command. For 'use', cmd->courseName points into line.
+void parse_workspace_command(const char *line, Command *cmd) {
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->type = CMD_NONE;
+
+    if (!line) {
+        return;
+    }
+
+    // Skip leading whitespace
+    while (*line == ' ' || *line == '\t') {
+        line++;
+    }
+
+    // Check for empty line
+    if (*line == '\0') {
+        return;
+    }
+
+    // Check for the --all flag at the end of a student or stats command
+    // Other commands keep the whole line, since " --all" can be part of
+    // an assignment name
+    size_t len = strlen(line);
+    bool all = len >= 6 && strcmp(line + len - 6, " --all") == 0;
+    len -= all ? 6 : 0;
+
+    if (all && len == 8 + 10 && strncmp(line, "student ", 8) == 0) {
+        // Cross-course student command - exactly a 10-digit ID
+        memcpy(cmd->studentId, line + 8, 10);
+        cmd->studentId[10] = '\0';
+        cmd->type = is_valid_student_id(cmd->studentId) ? CMD_STUDENT_ALL : CMD_INVALID;
+    }
+    else if (all && len > 6 && strncmp(line, "stats ", 6) == 0) {
+        // Cross-course stats command - assignment name before the flag
+        cmd->type = CMD_INVALID;
+        if (len - 6 < sizeof(cmd->assignmentName)) {
+            memcpy(cmd->assignmentName, line + 6, len - 6);
+            cmd->assignmentName[len - 6] = '\0';
+            if (is_valid_assignment_pattern(cmd->assignmentName)) {
+                cmd->type = CMD_STATS_ALL;
+            }
+        }
+    }
+    else if (strncmp(line, "use ", 4) == 0) {
+        // Use command - switch to the named course
+        cmd->type = CMD_USE;
+        cmd->courseName = line + 4;
+    }
+    else if (strcmp(line, "courses") == 0) {
+        cmd->type = CMD_COURSES;
+    }
+    else {
+        // Single-course command
+        parse_command(line, cmd);
+    }
+}
+
+// Execute a parsed command against the workspace
+// Workspace commands run here; everything else runs on the current course
+void execute_workspace_command(const Command *cmd, Workspace *ws) {
+    if (!cmd || !ws) {
+        return;
+    }
+
+    switch (cmd->type) {
+    case CMD_NONE:
+        break;
+    case CMD_USE:
+        cmd_use(ws, cmd->courseName);
+        break;
+    case CMD_COURSES:
+        cmd_courses(ws);
+        break;
+    case CMD_STUDENT_ALL:
+        cmd_student_all(ws, cmd->studentId);
+        break;
+    case CMD_STATS_ALL:
+        cmd_stats_all(ws, cmd->assignmentName);
+        break;
+    default: {
+        // Single-course command - load the current course if needed
+        Course *course = &ws->courses[ws->current];
+        GradeList *list = course_list(course);
+        if (!list) {
+            fprintf(command_stream(), "Error: Failed to load course '%s'\n", course->name);
+            return;
+        }
+
+        execute_command(cmd, list);
+        break;
+    }
+    }
+}
+
+// Workspace command processor - handles course selection and cross-course
+// queries, and passes everything else to the current course
+void process_workspace_command(char *line, Workspace *ws) {
+    if (!line || !ws) {
+        return;
+    }
+
+    Command cmd;
+    parse_workspace_command(line, &cmd);
+    execute_workspace_command(&cmd, ws);
+}